@@ -125,12 +125,12 @@ public:
 
     const_pointer data(const location_type& location) const
     {
-        return view().data();
+        return view().data(location);
     }
 
     pointer data(const location_type& location)
     {
-        return view().data();
+        return view().data(location);
     }
 
     const_reference operator [](const location_type& location) const
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
 #include <cpp_essentials/core/function_defs.hpp>
 #include <cpp_essentials/geo/linear_shape.hpp>
 
@@ -44,6 +49,115 @@ inline void bresenham(
     }
 }
 
+/* Closed form of the walk of bresenham_line: every step advances the major axis by one pixel, and after k steps the minor axis
+   has advanced ceil((k * dist[minor] - dist[major] / 2) / dist[major]) pixels, so a walk can start at any step. */
+struct bresenham_steps
+{
+    bresenham_steps(const point& start, const point& end)
+        : start(start)
+        , dist{ std::abs(end.x() - start.x()), std::abs(end.y() - start.y()) }
+        , dir{ end.x() < start.x() ? -1 : 1, end.y() < start.y() ? -1 : 1 }
+        , major(dist.x() > dist.y() ? 0 : 1)
+        , minor(1 - major)
+        , initial_error((dist.x() > dist.y() ? dist.x() : -dist.y()) / 2)
+    {
+    }
+
+    int count() const
+    {
+        return dist[major];
+    }
+
+    int minor_steps(int k) const
+    {
+        if (dist[major] == 0)
+        {
+            return 0;
+        }
+
+        return int((std::int64_t(k) * dist[minor] - dist[major] / 2 + dist[major] - 1) / dist[major]);
+    }
+
+    point position(int k) const
+    {
+        auto result = start;
+        result[major] += dir[major] * k;
+        result[minor] += dir[minor] * minor_steps(k);
+        return result;
+    }
+
+    /* the error term bresenham holds after k steps */
+    int error(int k) const
+    {
+        const auto delta = std::int64_t(minor_steps(k)) * dist[major] - std::int64_t(k) * dist[minor];
+
+        return int(major == 0 ? initial_error + delta : initial_error - delta);
+    }
+
+    /* [first, last] steps whose pixels lie in [lower, upper); first > last when there are none */
+    std::pair<int, int> visible(const point& lower, const point& upper) const
+    {
+        /* the range of advances f such that start + dir * f lies in [lower, upper) along the axis */
+        const auto advances = [&](int axis) -> std::pair<std::int64_t, std::int64_t>
+        {
+            const std::int64_t s = start[axis];
+
+            return dir[axis] > 0
+                ? std::make_pair(lower[axis] - s, upper[axis] - 1 - s)
+                : std::make_pair(s - upper[axis] + 1, s - lower[axis]);
+        };
+
+        const auto along = advances(major);
+        const auto across = advances(minor);
+
+        auto first = int(std::max<std::int64_t>(along.first, 0));
+        auto last = int(std::min<std::int64_t>(along.second, count()));
+
+        if (first > last)
+        {
+            return { first, last };
+        }
+
+        /* minor_steps is non-decreasing, so the visible steps along the minor axis are found by bisection */
+        for (auto hi = last + 1; first < hi;)
+        {
+            const auto mid = first + (hi - first) / 2;
+
+            if (minor_steps(mid) < across.first)
+            {
+                first = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        for (auto lo = first - 1; lo < last;)
+        {
+            const auto mid = last - (last - lo) / 2;
+
+            if (minor_steps(mid) > across.second)
+            {
+                last = mid - 1;
+            }
+            else
+            {
+                lo = mid;
+            }
+        }
+
+        return { first, last };
+    }
+
+    point start;
+    vector dist;
+    vector dir;
+    int major;
+    int minor;
+    int initial_error;
+};
+
 struct bresenham_line_fn
 {
     void operator ()(
@@ -1,11 +1,18 @@
 #ifndef CPP_ESSENTIALS_GX_BITMAP_HPP_
 #define CPP_ESSENTIALS_GX_BITMAP_HPP_
 
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <vector>
 
 #include <cpp_essentials/core/algorithm.hpp>
 
 #include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/bgr_swizzle.hpp>
+#include <cpp_essentials/gx/detail/lut_apply.hpp>
+#include <cpp_essentials/gx/detail/mapped_file.hpp>
 
 namespace cpp_essentials::gx
 {
@@ -27,12 +34,12 @@ T read(std::istream& is)
     return value;
 }
 
-inline void write_n(std::ostream& os, size_t count, char value = 0)
+template <class T>
+T read_at(const unsigned char* ptr, size_t offset)
 {
-    for (size_t i = 0; i < count; ++i)
-    {
-        write<char>(os, value);
-    }
+    T value;
+    std::memcpy(&value, ptr + offset, sizeof(T));
+    return value;
 }
 
 inline size_t get_padding(size_t width, size_t bits_per_pixel)
@@ -76,7 +83,7 @@ struct bmp_header
 
 struct dib_header
 {
-    static const size_t size;
+    static constexpr size_t size = 40;
 
     dib_header()
         : width(0)
@@ -134,8 +141,6 @@ struct dib_header
     }
 };
 
-const size_t dib_header::size = 40;
-
 inline void save_header(
     std::ostream& os,
     size_t width,
@@ -164,42 +169,49 @@ inline void save_header(
     dib_hdr.save(os);
 }
 
+template <class T>
+void read_n(std::istream& is, T* ptr, size_t count)
+{
+    is.read(reinterpret_cast<char*>(ptr), count * sizeof(T));
+}
+
+template <class T>
+void write_n(std::ostream& os, const T* ptr, size_t count)
+{
+    os.write(reinterpret_cast<const char*>(ptr), count * sizeof(T));
+}
+
 inline rgb_image load_bitmap_8(const detail::dib_header& header, std::istream& is)
 {
     rgb_image result({ header.width, header.height });
 
     auto padding = detail::get_padding(result.width(), header.bits_per_pixel);
 
+    std::array<byte, 256 * 4> entries;
+    read_n(is, entries.data(), entries.size());
+
     std::array<rgb_color, 256> palette;
 
     for (size_t i = 0; i < 256; ++i)
     {
-        auto b = detail::read<byte>(is);
-        auto g = detail::read<byte>(is);
-        auto r = detail::read<byte>(is);
+        palette[i] = { entries[4 * i + 2], entries[4 * i + 1], entries[4 * i + 0] };
+    }
 
-        is.ignore(1);
+    const detail::palette_rows lookup{ palette };
 
-        palette[i] = { r, g, b };
-    }
+    std::vector<byte> buffer(result.width() + padding);
 
     for (int y = int(result.height()) - 1; y >= 0; --y)
     {
-        auto row = result[y];
+        read_n(is, buffer.data(), buffer.size());
 
-        for (int x = 0; x < result.width(); ++x)
-        {
-            auto color = detail::read<byte>(is);
-
-            row[x] = palette[color];
-        }
-
-        is.ignore(padding);
+        lookup(buffer.data(), reinterpret_cast<byte*>(result.data({ 0, y })), result.width());
     }
 
     return result;
 }
 
+/* Rows are read straight into the image and swizzled in place. */
 inline rgb_image load_bitmap_24(const detail::dib_header& header, std::istream& is)
 {
     rgb_image result({ header.width, header.height });
@@ -208,18 +220,12 @@ inline rgb_image load_bitmap_24(const detail::dib_header& header, std::istream&
 
     for (int y = int(result.height()) - 1; y >= 0; --y)
     {
-        auto row = result[y];
-
-        for (int x = 0; x < (int)result.width(); ++x)
-        {
-            auto b = detail::read<byte>(is);
-            auto g = detail::read<byte>(is);
-            auto r = detail::read<byte>(is);
-
-            row[x] = rgb_color(r, g, b);
-        }
+        auto* row = reinterpret_cast<byte*>(result.data({ 0, y }));
 
+        read_n(is, row, 3 * size_t(result.width()));
         is.ignore(padding);
+
+        swap_red_blue(row, 3, row, result.width());
     }
 
     return result;
@@ -234,28 +240,39 @@ struct save_bitmap_fn
 
         detail::save_header(os, view.width(), view.height(), padding, bits_per_pixel, 256 * 4);
 
+        std::array<byte, 256 * 4> palette;
+
         for (size_t i = 0; i < 256; ++i)
         {
-            for (size_t j = 0; j < 3; ++j)
-            {
-                detail::write<char>(os, i);
-            }
-
-            detail::write<char>(os, 0);
+            palette[4 * i + 0] = byte(i);
+            palette[4 * i + 1] = byte(i);
+            palette[4 * i + 2] = byte(i);
+            palette[4 * i + 3] = 0;
         }
 
+        detail::write_n(os, palette.data(), palette.size());
+
+        const auto step = view.stride()[0];
+
+        std::vector<byte> buffer(view.width() + padding, 0);
+
         for (int y = (int)view.height() - 1; y >= 0; --y)
         {
-            auto row = view[y];
+            const auto* src = view.data({ 0, y });
 
-            for (int x = 0; x < view.width(); ++x)
+            if (step == 1)
             {
-                auto value = row[x];
-
-                detail::write<byte>(os, value);
+                std::copy(src, src + view.width(), buffer.begin());
+            }
+            else
+            {
+                for (int x = 0; x < view.width(); ++x, src += step)
+                {
+                    buffer[x] = *src;
+                }
             }
 
-            detail::write_n(os, padding);
+            detail::write_n(os, buffer.data(), buffer.size());
         }
     }
 
@@ -273,20 +290,15 @@ struct save_bitmap_fn
 
         detail::save_header(os, view.width(), view.height(), padding, bits_per_pixel, 0);
 
-        for (int y = int(view.height()) - 1; y >= 0; --y)
-        {
-            auto row = view[y];
+        const auto step = view.stride()[0];
 
-            for (int x = 0; x < view.width(); ++x)
-            {
-                auto value = row[x];
+        std::vector<byte> buffer(3 * view.width() + padding, 0);
 
-                detail::write<byte>(os, value.blue());
-                detail::write<byte>(os, value.green());
-                detail::write<byte>(os, value.red());
-            }
+        for (int y = int(view.height()) - 1; y >= 0; --y)
+        {
+            detail::swap_red_blue(reinterpret_cast<const byte*>(view.data({ 0, y })), step, buffer.data(), view.width());
 
-            detail::write_n(os, padding);
+            detail::write_n(os, buffer.data(), buffer.size());
         }
     }
 
@@ -337,8 +349,105 @@ struct load_bitmap_fn
 
 } /* namespace detail */
 
+/* Uncompressed 24-bit bitmap file mapped into memory; view() addresses the pixels in place, bottom-up files through a negative row stride.
+   Views are valid as long as the mapped_bitmap is alive. */
+class mapped_bitmap
+{
+public:
+    using view_type = bgr_image::const_view_type;
+
+    explicit mapped_bitmap(const std::string& file)
+        : _file(file)
+        , _view(make_view(_file))
+    {
+    }
+
+    view_type view() const
+    {
+        return _view;
+    }
+
+    size_type size() const
+    {
+        return _view.size();
+    }
+
+    int width() const
+    {
+        return _view.width();
+    }
+
+    int height() const
+    {
+        return _view.height();
+    }
+
+private:
+    static view_type make_view(const detail::mapped_file& file)
+    {
+        const auto* ptr = file.data();
+
+        if (file.size() < detail::bmp_header::size + detail::dib_header::size || ptr[0] != 'B' || ptr[1] != 'M')
+        {
+            throw std::runtime_error{ "map_bitmap: invalid file" };
+        }
+
+        const auto data_offset = size_t(detail::read_at<std::uint32_t>(ptr, 10));
+        const auto width = detail::read_at<std::int32_t>(ptr, 18);
+        const auto height = detail::read_at<std::int32_t>(ptr, 22);
+        const auto bits_per_pixel = detail::read_at<std::uint16_t>(ptr, 28);
+        const auto compression = detail::read_at<std::uint32_t>(ptr, 30);
+
+        if (bits_per_pixel != 24 || compression != 0 || width < 0)
+        {
+            throw std::runtime_error{ "map_bitmap: format not supported" };
+        }
+
+        const auto rows = height < 0 ? -std::int64_t(height) : std::int64_t(height);
+        const auto row_size = 3 * size_t(width) + detail::get_padding(size_t(width), 24);
+
+        /* array_view computes pixel offsets in int */
+        const auto max_offset = size_t(std::numeric_limits<int>::max());
+
+        if (size_t(rows) > max_offset || row_size > max_offset || row_size * size_t(rows) > max_offset)
+        {
+            throw std::runtime_error{ "map_bitmap: file too large" };
+        }
+
+        if (data_offset + row_size * size_t(rows) > file.size())
+        {
+            throw std::runtime_error{ "map_bitmap: truncated file" };
+        }
+
+        const auto* first_row = ptr + data_offset + (height > 0 ? row_size * size_t(rows - 1) : 0);
+        const auto row_step = height > 0 ? -std::ptrdiff_t(row_size) : std::ptrdiff_t(row_size);
+
+        return view_type{
+            reinterpret_cast<const bgr_color*>(first_row),
+            { width, int(rows) },
+            { 3, int(row_step) } };
+    }
+
+    detail::mapped_file _file;
+    view_type _view;
+};
+
+namespace detail
+{
+
+struct map_bitmap_fn
+{
+    mapped_bitmap operator ()(const std::string& file) const
+    {
+        return mapped_bitmap{ file };
+    }
+};
+
+} /* namespace detail */
+
 static constexpr auto save_bitmap = detail::save_bitmap_fn{};
 static constexpr auto load_bitmap = detail::load_bitmap_fn{};
+static constexpr auto map_bitmap = detail::map_bitmap_fn{};
 
 } /* namespace cpp_essentials::gx */
 
@@ -0,0 +1,212 @@
+#ifndef CPP_ESSENTIALS_GX_BLENDING_HPP_
+#define CPP_ESSENTIALS_GX_BLENDING_HPP_
+
+#pragma once
+
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/detail/blending.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+struct mode_row_blend
+{
+    blend_mode mode;
+
+    void operator ()(const byte* lhs, const byte* rhs, byte* dst, int count, simd_level level) const
+    {
+        blend_row(mode, lhs, rhs, dst, count, level);
+    }
+};
+
+struct ratio_row_blend
+{
+    explicit ratio_row_blend(float ratio)
+        : weight(to_byte(ratio * 255.F + 0.5F))
+    {
+    }
+
+    void operator ()(const byte* lhs, const byte* rhs, byte* dst, int count, simd_level level) const
+    {
+        mix_row(lhs, rhs, weight, dst, count, level);
+    }
+
+    byte weight;
+};
+
+/* Blends whole images with the rules of the corresponding gx::filters functors. With a mask, the blended value is mixed
+   with lhs by the mask value of each pixel (255 gives the blended value). dest may be lhs or rhs.
+   The ratio overloads stand for filters::blend: the ratio is rounded to a multiple of 1 / 255 and the result is rounded
+   rather than truncated, so it may exceed the filter's by one. */
+struct blend_images_fn
+{
+    void operator ()(blend_mode mode, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::view_type dest) const
+    {
+        run<1>(mode_row_blend{ mode }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(blend_mode mode, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::const_view_type mask, byte_image::view_type dest) const
+    {
+        run<1>(mode_row_blend{ mode }, lhs, rhs, &mask, dest, 0, dest.height());
+    }
+
+    void operator ()(blend_mode mode, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, rgb_image::view_type dest) const
+    {
+        run<3>(mode_row_blend{ mode }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(blend_mode mode, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, byte_image::const_view_type mask, rgb_image::view_type dest) const
+    {
+        run<3>(mode_row_blend{ mode }, lhs, rhs, &mask, dest, 0, dest.height());
+    }
+
+    void operator ()(blend_mode mode, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, rgba_image::view_type dest) const
+    {
+        run<4>(mode_row_blend{ mode }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(blend_mode mode, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, byte_image::const_view_type mask, rgba_image::view_type dest) const
+    {
+        run<4>(mode_row_blend{ mode }, lhs, rhs, &mask, dest, 0, dest.height());
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::view_type dest) const
+    {
+        run<1>(policy, mode_row_blend{ mode }, lhs, rhs, nullptr, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::const_view_type mask, byte_image::view_type dest) const
+    {
+        run<1>(policy, mode_row_blend{ mode }, lhs, rhs, &mask, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, rgb_image::view_type dest) const
+    {
+        run<3>(policy, mode_row_blend{ mode }, lhs, rhs, nullptr, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, byte_image::const_view_type mask, rgb_image::view_type dest) const
+    {
+        run<3>(policy, mode_row_blend{ mode }, lhs, rhs, &mask, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, rgba_image::view_type dest) const
+    {
+        run<4>(policy, mode_row_blend{ mode }, lhs, rhs, nullptr, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, blend_mode mode, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, byte_image::const_view_type mask, rgba_image::view_type dest) const
+    {
+        run<4>(policy, mode_row_blend{ mode }, lhs, rhs, &mask, dest);
+    }
+
+    void operator ()(float ratio, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::view_type dest) const
+    {
+        run<1>(ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(float ratio, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, rgb_image::view_type dest) const
+    {
+        run<3>(ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(float ratio, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, rgba_image::view_type dest) const
+    {
+        run<4>(ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest, 0, dest.height());
+    }
+
+    void operator ()(const execution::parallel_policy& policy, float ratio, byte_image::const_view_type lhs, byte_image::const_view_type rhs, byte_image::view_type dest) const
+    {
+        run<1>(policy, ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, float ratio, rgb_image::const_view_type lhs, rgb_image::const_view_type rhs, rgb_image::view_type dest) const
+    {
+        run<3>(policy, ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, float ratio, rgba_image::const_view_type lhs, rgba_image::const_view_type rhs, rgba_image::view_type dest) const
+    {
+        run<4>(policy, ratio_row_blend{ ratio }, lhs, rhs, nullptr, dest);
+    }
+
+private:
+    template <size_t Channels, class RowBlend, class SourceView, class DestView>
+    static void run(const RowBlend& row_blend, const SourceView& lhs, const SourceView& rhs, const byte_image::const_view_type* mask, const DestView& dest, int begin, int end)
+    {
+        run<Channels>(row_blend, lhs, rhs, mask, dest, [&](auto&& func) { func(begin, end); });
+    }
+
+    template <size_t Channels, class RowBlend, class SourceView, class DestView>
+    static void run(const execution::parallel_policy& policy, const RowBlend& row_blend, const SourceView& lhs, const SourceView& rhs, const byte_image::const_view_type* mask, const DestView& dest)
+    {
+        run<Channels>(row_blend, lhs, rhs, mask, dest, [&](auto&& func) { parallel_for_bands(policy, dest.height(), 16, func); });
+    }
+
+    /* Views with strided rows are copied to contiguous images first. */
+    template <size_t Channels, class RowBlend, class SourceView, class DestView, class Schedule>
+    static void run(const RowBlend& row_blend, const SourceView& lhs, const SourceView& rhs, const byte_image::const_view_type* mask, const DestView& dest, Schedule&& schedule)
+    {
+        using image_type = image<typename DestView::value_type>;
+
+        EXPECTS(lhs.size() == dest.size() && rhs.size() == dest.size(), "blend_images: size mismatch");
+        EXPECTS(!mask || mask->size() == dest.size(), "blend_images: mask size mismatch");
+
+        if (!is_contiguous_row(lhs) || !is_contiguous_row(rhs) || !is_contiguous_row(dest) || (mask && !is_contiguous_row(*mask)))
+        {
+            const image_type l{ lhs };
+            const image_type r{ rhs };
+            const auto m = mask ? byte_image{ *mask } : byte_image{};
+            const auto m_view = m.view();
+
+            image_type result{ dest.size() };
+
+            run<Channels>(row_blend, l.view(), r.view(), mask ? &m_view : nullptr, result.view(), std::forward<Schedule>(schedule));
+            copy_view(result.view(), dest);
+            return;
+        }
+
+        const auto count = dest.width() * int(Channels);
+        const auto level = get_simd_level();
+
+        schedule([&](int begin, int end)
+        {
+            std::vector<byte> blended(mask ? size_t(count) : 0);
+            std::vector<byte> weights(mask ? size_t(count) : 0);
+
+            for (int y = begin; y < end; ++y)
+            {
+                const auto* l = reinterpret_cast<const byte*>(lhs.data({ 0, y }));
+                const auto* r = reinterpret_cast<const byte*>(rhs.data({ 0, y }));
+                auto* d = reinterpret_cast<byte*>(dest.data({ 0, y }));
+
+                if (mask)
+                {
+                    expand_mask_row<Channels>(mask->data({ 0, y }), weights.data(), dest.width());
+
+                    row_blend(l, r, blended.data(), count, level);
+                    mix_row(l, blended.data(), weights.data(), d, count, level);
+                }
+                else
+                {
+                    row_blend(l, r, d, count, level);
+                }
+            }
+        });
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto blend_images = detail::blend_images_fn{};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_BLENDING_HPP_ */
@@ -0,0 +1,198 @@
+#ifndef CPP_ESSENTIALS_GX_COLOR_CONVERSION_HPP_
+#define CPP_ESSENTIALS_GX_COLOR_CONVERSION_HPP_
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/planar_image.hpp>
+#include <cpp_essentials/gx/detail/color_conversion.hpp>
+#include <cpp_essentials/gx/detail/planar_conversion.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class color_space
+{
+    hsv,
+    hsl,
+    yuv,
+    yiq,
+    cmyk
+};
+
+namespace detail
+{
+
+template <class Func>
+void visit_conversion(color_space space, Func&& func)
+{
+    static const matrix_conversion yuv{ yuv_matrix };
+    static const matrix_conversion yiq{ yiq_matrix };
+
+    switch (space)
+    {
+        case color_space::hsv: return func(hsv_conversion{});
+        case color_space::hsl: return func(hsl_conversion{});
+        case color_space::yuv: return func(yuv);
+        case color_space::yiq: return func(yiq);
+        case color_space::cmyk: return func(cmyk_conversion{});
+    }
+}
+
+/* Each row is split into byte planes, converted a vector at a time and written to the float planes. */
+template <class Func, size_t Channels>
+void rgb_to_planes(const Func& func, rgb_image::const_view_type source, const std::array<image<float>::view_type, Channels>& planes, int begin, int end, simd_level level)
+{
+    std::vector<byte> buffer(3 * size_t(source.width()));
+    const std::array<byte*, 3> rgb{ { buffer.data(), buffer.data() + source.width(), buffer.data() + 2 * source.width() } };
+
+    for (int y = begin; y < end; ++y)
+    {
+        std::array<float*, Channels> dst;
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[c] = planes[c].data({ 0, y });
+        }
+
+        deinterleave_row(reinterpret_cast<const byte*>(source.data({ 0, y })), source.stride()[0], rgb, source.width(), level);
+        transform_planes(func, std::array<const byte*, 3>{ { rgb[0], rgb[1], rgb[2] } }, dst, source.width(), level);
+    }
+}
+
+template <class Func, size_t Channels>
+void planes_to_rgb(const Func& func, const std::array<image<float>::const_view_type, Channels>& planes, rgb_image::view_type dest, int begin, int end, simd_level level)
+{
+    std::vector<byte> buffer(3 * size_t(dest.width()));
+    const std::array<byte*, 3> rgb{ { buffer.data(), buffer.data() + dest.width(), buffer.data() + 2 * dest.width() } };
+
+    for (int y = begin; y < end; ++y)
+    {
+        std::array<const float*, Channels> src;
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            src[c] = planes[c].data({ 0, y });
+        }
+
+        transform_planes(func, src, rgb, dest.width(), level);
+        interleave_row(std::array<const byte*, 3>{ { rgb[0], rgb[1], rgb[2] } }, reinterpret_cast<byte*>(dest.data({ 0, y })), dest.stride()[0], dest.width(), level);
+    }
+}
+
+template <size_t Channels>
+void to_color_space(color_space space, rgb_image::const_view_type source, planar_image<float, Channels>& dest)
+{
+    EXPECTS(source.size() == dest.size(), "to_color_space: size mismatch");
+
+    visit_conversion(space, [&](const auto& conversion)
+    {
+        using conversion_type = std::decay_t<decltype(conversion)>;
+
+        EXPECTS(conversion_type::channels == Channels, "to_color_space: channel count mismatch");
+
+        if constexpr (conversion_type::channels == Channels)
+        {
+            rgb_to_planes(forward_conversion<conversion_type>{ conversion }, source, dest.channels(), 0, source.height(), get_simd_level());
+        }
+    });
+}
+
+template <size_t Channels>
+void from_color_space(color_space space, const planar_image<float, Channels>& source, rgb_image::view_type dest)
+{
+    EXPECTS(source.size() == dest.size(), "from_color_space: size mismatch");
+
+    visit_conversion(space, [&](const auto& conversion)
+    {
+        using conversion_type = std::decay_t<decltype(conversion)>;
+
+        EXPECTS(conversion_type::channels == Channels, "from_color_space: channel count mismatch");
+
+        if constexpr (conversion_type::channels == Channels)
+        {
+            planes_to_rgb(backward_conversion<conversion_type>{ conversion }, source.channels(), dest, 0, dest.height(), get_simd_level());
+        }
+    });
+}
+
+struct to_color_space_fn
+{
+    /* hsv, hsl, yuv and yiq */
+    void operator ()(color_space space, rgb_image::const_view_type source, planar_image<float, 3>& dest) const
+    {
+        to_color_space(space, source, dest);
+    }
+
+    /* cmyk */
+    void operator ()(color_space space, rgb_image::const_view_type source, planar_image<float, 4>& dest) const
+    {
+        to_color_space(space, source, dest);
+    }
+};
+
+struct from_color_space_fn
+{
+    void operator ()(color_space space, const planar_image<float, 3>& source, rgb_image::view_type dest) const
+    {
+        from_color_space(space, source, dest);
+    }
+
+    void operator ()(color_space space, const planar_image<float, 4>& source, rgb_image::view_type dest) const
+    {
+        from_color_space(space, source, dest);
+    }
+};
+
+/* Rotates the hue by hue_shift degrees and scales the saturation, going through hsv a vector of pixels at a time. */
+struct adjust_hue_saturation_fn
+{
+    void operator ()(rgb_image::const_view_type source, rgb_image::view_type dest, float hue_shift, float saturation_scale) const
+    {
+        run(source, dest, hue_shift, saturation_scale, 0, dest.height());
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgb_image::const_view_type source, rgb_image::view_type dest, float hue_shift, float saturation_scale) const
+    {
+        parallel_for_bands(policy, dest.height(), 16, [&](int begin, int end)
+        {
+            run(source, dest, hue_shift, saturation_scale, begin, end);
+        });
+    }
+
+private:
+    static void run(rgb_image::const_view_type source, rgb_image::view_type dest, float hue_shift, float saturation_scale, int begin, int end)
+    {
+        EXPECTS(source.size() == dest.size(), "adjust_hue_saturation: size mismatch");
+
+        const auto level = get_simd_level();
+        const hue_saturation_adjustment adjustment{ hue_shift, saturation_scale };
+
+        const auto width = dest.width();
+
+        std::vector<byte> buffer(6 * size_t(width));
+        const std::array<byte*, 3> in{ { buffer.data(), buffer.data() + width, buffer.data() + 2 * width } };
+        const std::array<byte*, 3> out{ { buffer.data() + 3 * width, buffer.data() + 4 * width, buffer.data() + 5 * width } };
+
+        for (int y = begin; y < end; ++y)
+        {
+            deinterleave_row(reinterpret_cast<const byte*>(source.data({ 0, y })), source.stride()[0], in, width, level);
+            transform_planes(adjustment, std::array<const byte*, 3>{ { in[0], in[1], in[2] } }, out, width, level);
+            interleave_row(std::array<const byte*, 3>{ { out[0], out[1], out[2] } }, reinterpret_cast<byte*>(dest.data({ 0, y })), dest.stride()[0], width, level);
+        }
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto to_color_space = detail::to_color_space_fn{};
+static constexpr auto from_color_space = detail::from_color_space_fn{};
+static constexpr auto adjust_hue_saturation = detail::adjust_hue_saturation_fn{};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_COLOR_CONVERSION_HPP_ */
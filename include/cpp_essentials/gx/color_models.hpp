@@ -7,6 +7,7 @@
 
 #include <cpp_essentials/geo/matrix.hpp>
 #include <cpp_essentials/core/algorithm.hpp>
+#include <cpp_essentials/core/output.hpp>
 
 #include <cpp_essentials/gx/core.hpp>
 #include <cpp_essentials/core/views/map.hpp>
@@ -298,6 +299,86 @@ inline bool operator !=(const rgba_color& lhs, const rgba_color& rhs)
 }
 
 
+/* Blue-green-red byte order, as stored by 24-bit bitmaps; lets bgr pixel data be viewed without conversion. */
+struct bgr_color
+{
+    using const_reference = const byte&;
+    using reference = byte & ;
+
+    bgr_color()
+        : bgr_color(rgb_color{})
+    {
+    }
+
+    bgr_color(const rgb_color& color)
+        : data{ color[2], color[1], color[0] }
+    {
+    }
+
+    rgb_color to_rgb() const
+    {
+        return { data[2], data[1], data[0] };
+    }
+
+    operator rgb_color() const
+    {
+        return to_rgb();
+    }
+
+    byte gray() const
+    {
+        return to_rgb().gray();
+    }
+
+    const_reference red() const
+    {
+        return data[2];
+    }
+
+    reference red()
+    {
+        return data[2];
+    }
+
+    const_reference green() const
+    {
+        return data[1];
+    }
+
+    reference green()
+    {
+        return data[1];
+    }
+
+    const_reference blue() const
+    {
+        return data[0];
+    }
+
+    reference blue()
+    {
+        return data[0];
+    }
+
+    geo::vector<byte, 3> data;
+};
+
+inline std::ostream& operator <<(std::ostream& os, const bgr_color& item)
+{
+    return os << item.to_rgb();
+}
+
+inline bool operator ==(const bgr_color& lhs, const bgr_color& rhs)
+{
+    return lhs.data == rhs.data;
+}
+
+inline bool operator !=(const bgr_color& lhs, const bgr_color& rhs)
+{
+    return !(lhs == rhs);
+}
+
+
 struct hsv_color
 {
     double h, s, v;
@@ -0,0 +1,367 @@
+#ifndef CPP_ESSENTIALS_GX_COMMAND_BUFFER_HPP_
+#define CPP_ESSENTIALS_GX_COMMAND_BUFFER_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <cpp_essentials/gx/drawing_context.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+struct pixel_command
+{
+    point location;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.draw_pixel(location, color, alpha);
+    }
+};
+
+struct line_command
+{
+    point start;
+    point end;
+    bool smooth;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        if (smooth)
+        {
+            context.draw_line_smooth(start, end, color, alpha);
+        }
+        else
+        {
+            context.draw_line(start, end, color, alpha);
+        }
+    }
+};
+
+struct circle_command
+{
+    point center;
+    int radius;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.draw_circle(center, radius, color, alpha);
+    }
+};
+
+struct fill_rect_command
+{
+    rect area;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.fill(area, color, alpha);
+    }
+};
+
+struct fill_polygon_command
+{
+    geo::polygon_2d<double> shape;
+    fill_rule rule;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.fill(shape, color, alpha, rule);
+    }
+};
+
+struct text_command
+{
+    std::string text;
+    point location;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.draw(text, location, color, alpha);
+    }
+};
+
+struct dot_command
+{
+    point location;
+
+    template <class Context, class Color>
+    void operator ()(Context& context, const Color& color, byte alpha) const
+    {
+        context.draw_dot(location, color, alpha);
+    }
+};
+
+} /* namespace detail */
+
+/* Records drawing commands and replays them on an image later. The parallel render bins the commands by the tiles their
+   bounds overlap and rasterizes the tiles concurrently, each with its own drawing_context; every primitive produces the same
+   pixels whatever the clip region, and commands keep their order within a tile, so the result equals the sequential render. */
+template <class Color>
+class command_buffer
+{
+public:
+    using color_type = Color;
+    using view_type = typename arrays::array<color_type, 2>::view_type;
+
+    command_buffer& draw_pixel(const point& point, color_type color, byte alpha = 255)
+    {
+        return add(detail::pixel_command{ point }, { point, point + gx::point{ 1, 1 } }, color, alpha);
+    }
+
+    command_buffer& draw_line(const point& start, const point& end, color_type color, byte alpha = 255)
+    {
+        return add(detail::line_command{ start, end, false }, detail::get_bounds(start, end, 0), color, alpha);
+    }
+
+    command_buffer& draw_line_smooth(const point& start, const point& end, color_type color, byte alpha = 255)
+    {
+        return add(detail::line_command{ start, end, true }, detail::get_bounds(start, end, 1), color, alpha);
+    }
+
+    command_buffer& draw_circle(const point& center, int radius, color_type color, byte alpha = 255)
+    {
+        return add(detail::circle_command{ center, radius }, detail::get_bounds(center, center, std::abs(radius)), color, alpha);
+    }
+
+    template <class T>
+    command_buffer& draw(const geo::vector_2d<T>& point, color_type color, byte alpha = 255)
+    {
+        return draw_pixel(point, color, alpha);
+    }
+
+    template <class T>
+    command_buffer& draw(const geo::segment_2d<T>& line, color_type color, byte alpha = 255)
+    {
+        return draw_line(line[0], line[1], color, alpha);
+    }
+
+    template <class T>
+    command_buffer& draw(const geo::rect<T>& rect, color_type color, byte alpha = 255)
+    {
+        return draw_segments(rect, color, alpha);
+    }
+
+    template <class T, size_t N, class Tag>
+    command_buffer& draw(const geo::vertex_array<T, 2, N, Tag>& shape, color_type color, byte alpha = 255)
+    {
+        return draw_segments(shape, color, alpha);
+    }
+
+    template <class T>
+    command_buffer& draw(const geo::circle_2d<T>& shape, color_type color, byte alpha = 255)
+    {
+        return draw_circle(shape.center(), shape.radius(), color, alpha);
+    }
+
+    command_buffer& fill(const rect& rect, color_type color, byte alpha = 255)
+    {
+        const image_region_t bounds{
+            location_type{ geo::left(rect), geo::top(rect) },
+            location_type{ geo::right(rect) + 1, geo::bottom(rect) + 1 } };
+
+        return add(detail::fill_rect_command{ rect }, bounds, color, alpha);
+    }
+
+    template <class T, size_t N>
+    command_buffer& fill(const geo::vertex_array<T, 2, N, geo::detail::polygon_tag>& shape, color_type color, byte alpha = 255, fill_rule rule = fill_rule::non_zero)
+    {
+        const auto count = geo::vertex_count(shape);
+
+        if (count == 0)
+        {
+            return *this;
+        }
+
+        double min_x = geo::get_vertex(shape, 0).x();
+        double min_y = geo::get_vertex(shape, 0).y();
+        double max_x = min_x;
+        double max_y = min_y;
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            const auto v = geo::get_vertex(shape, i);
+
+            min_x = std::min<double>(min_x, v.x());
+            min_y = std::min<double>(min_y, v.y());
+            max_x = std::max<double>(max_x, v.x());
+            max_y = std::max<double>(max_y, v.y());
+        }
+
+        const image_region_t bounds{
+            location_type{ int(std::floor(min_x)), int(std::floor(min_y)) },
+            location_type{ int(std::ceil(max_x)) + 1, int(std::ceil(max_y)) + 1 } };
+
+        return add(detail::fill_polygon_command{ shape, rule }, bounds, color, alpha);
+    }
+
+    command_buffer& draw(const std::string& text, const point& location, color_type color, byte alpha = 255)
+    {
+        return add(detail::text_command{ text, location }, detail::get_text_bounds(text, location), color, alpha);
+    }
+
+    command_buffer& draw_text(const std::vector<text_label>& labels, color_type color, byte alpha = 255)
+    {
+        for (const auto& label : labels)
+        {
+            draw(label.text, label.location, color, alpha);
+        }
+
+        return *this;
+    }
+
+    template <class T>
+    command_buffer& draw_dot(const geo::vector_2d<T>& location, color_type color, byte alpha = 255)
+    {
+        const point loc = location;
+        return add(detail::dot_command{ loc }, detail::get_bounds(loc, loc, 1), color, alpha);
+    }
+
+    size_t size() const
+    {
+        return _commands.size();
+    }
+
+    bool empty() const
+    {
+        return _commands.empty();
+    }
+
+    void clear()
+    {
+        _commands.clear();
+    }
+
+    /* origin is the position of the view's top-left pixel in drawing coordinates, as in drawing_context */
+    void render(view_type view, const point& origin = {}) const
+    {
+        drawing_context<color_type> context{ view, origin };
+
+        for (const auto& cmd : _commands)
+        {
+            execute(context, cmd);
+        }
+    }
+
+    void render(const execution::parallel_policy& policy, view_type view, const size_type& tile_size = { 128, 128 }, const point& origin = {}) const
+    {
+        EXPECTS(tile_size.x() > 0 && tile_size.y() > 0, "command_buffer: empty tile size");
+
+        const auto columns = (view.width() + tile_size.x() - 1) / tile_size.x();
+        const auto rows = (view.height() + tile_size.y() - 1) / tile_size.y();
+
+        /* command indices per tile, in recording order */
+        std::vector<std::vector<size_t>> bins(size_t(columns) * size_t(rows));
+
+        const image_region_t view_region{ origin, origin + location_type{ view.width(), view.height() } };
+
+        for (size_t i = 0; i < _commands.size(); ++i)
+        {
+            const auto part = detail::intersect(_commands[i].bounds, view_region);
+
+            if (detail::is_empty(part))
+            {
+                continue;
+            }
+
+            const auto lower = part.lower() - origin;
+            const auto upper = part.upper() - origin;
+
+            for (auto y = lower.y() / tile_size.y(); y <= (upper.y() - 1) / tile_size.y(); ++y)
+            {
+                for (auto x = lower.x() / tile_size.x(); x <= (upper.x() - 1) / tile_size.x(); ++x)
+                {
+                    bins[size_t(y) * size_t(columns) + size_t(x)].push_back(i);
+                }
+            }
+        }
+
+        detail::parallel_for_bands(policy, int(bins.size()), 1, [&](int begin, int end)
+        {
+            for (auto index = begin; index < end; ++index)
+            {
+                if (bins[index].empty())
+                {
+                    continue;
+                }
+
+                const location_type tile{ index % columns, index / columns };
+                const auto lower = location_type{ tile.x() * tile_size.x(), tile.y() * tile_size.y() };
+                const auto upper = location_type{ std::min(lower.x() + tile_size.x(), view.width()), std::min(lower.y() + tile_size.y(), view.height()) };
+
+                drawing_context<color_type> context{ view.region({ lower, upper }), origin + lower };
+
+                for (auto i : bins[index])
+                {
+                    execute(context, _commands[i]);
+                }
+            }
+        });
+    }
+
+private:
+    using shape_type = std::variant<
+        detail::pixel_command,
+        detail::line_command,
+        detail::circle_command,
+        detail::fill_rect_command,
+        detail::fill_polygon_command,
+        detail::text_command,
+        detail::dot_command>;
+
+    struct command
+    {
+        shape_type shape;
+        image_region_t bounds;
+        color_type color;
+        byte alpha;
+    };
+
+    template <class S>
+    command_buffer& draw_segments(const S& shape, color_type color, byte alpha)
+    {
+        for (const auto& segment : geo::get_segments(shape))
+        {
+            draw(segment, color, alpha);
+        }
+
+        return *this;
+    }
+
+    command_buffer& add(shape_type shape, const image_region_t& bounds, color_type color, byte alpha)
+    {
+        if (alpha != 0 && !detail::is_empty(bounds))
+        {
+            _commands.push_back({ std::move(shape), bounds, color, alpha });
+        }
+
+        return *this;
+    }
+
+    static void execute(drawing_context<color_type>& context, const command& cmd)
+    {
+        std::visit([&](const auto& shape) { shape(context, cmd.color, cmd.alpha); }, cmd.shape);
+    }
+
+    std::vector<command> _commands;
+};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_COMMAND_BUFFER_HPP_ */
@@ -0,0 +1,187 @@
+#ifndef CPP_ESSENTIALS_GX_COMPONENT_LABELING_HPP_
+#define CPP_ESSENTIALS_GX_COMPONENT_LABELING_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/component_labeling.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class connectivity
+{
+    four,
+    eight
+};
+
+struct connected_component
+{
+    int area = 0;
+    image_region_t bounds;
+    geo::vector_2d<double> centroid;
+};
+
+/* labels holds 0 for the background and i + 1 for the pixels of components[i]; components are numbered in the raster order
+   of their first pixels. */
+struct component_labeling
+{
+    image<std::int32_t> labels;
+    std::vector<connected_component> components;
+};
+
+namespace detail
+{
+
+/* Two-pass labeling of the non-zero pixels. The image is cut into horizontal strips which are labeled independently, each
+   with its own range of provisional labels, and joined along the strip borders; the second pass resolves the labels and
+   gathers the statistics per strip. for_each_strip(count, func) calls func(index) for every strip, possibly concurrently. */
+template <class ForEachStrip>
+component_labeling label_components(byte_image::const_view_type source, gx::connectivity connectivity, int strip_count, ForEachStrip&& for_each_strip)
+{
+    const auto width = source.width();
+    const auto height = source.height();
+    const auto reach = connectivity == gx::connectivity::eight ? 1 : 0;
+
+    component_labeling result;
+    result.labels = image<std::int32_t>{ source.size() };
+
+    if (width == 0 || height == 0)
+    {
+        return result;
+    }
+
+    strip_count = std::max(std::min(strip_count, height), 1);
+
+    /* a row has at most (width + 1) / 2 runs, which bounds the provisional labels of a strip */
+    const auto row_labels = (width + 1) / 2;
+
+    std::vector<int> strips(strip_count + 1);
+    std::vector<std::int32_t> next(strip_count);
+
+    for (int i = 0; i <= strip_count; ++i)
+    {
+        strips[i] = int(height * static_cast<long long>(i) / strip_count);
+    }
+
+    label_equivalence equivalence{ size_t(height) * size_t(row_labels) + 1 };
+
+    const auto label_row_ptr = [&](int y) { return result.labels.data({ 0, y }); };
+
+    for_each_strip(strip_count, [&](int strip)
+    {
+        source_rows rows{ source, 1 };
+
+        next[strip] = std::int32_t(strips[strip] * row_labels + 1);
+
+        for (auto y = strips[strip]; y < strips[strip + 1]; ++y)
+        {
+            label_row(rows[y], y > strips[strip] ? label_row_ptr(y - 1) : nullptr, label_row_ptr(y), width, reach, equivalence, next[strip]);
+        }
+    });
+
+    for (int strip = 1; strip < strip_count; ++strip)
+    {
+        const auto y = strips[strip];
+
+        merge_row(label_row_ptr(y - 1), label_row_ptr(y), width, reach, equivalence);
+    }
+
+    /* parent[l] <= l, so visiting the labels in increasing order resolves each one from an already numbered parent */
+    std::vector<std::int32_t> final_labels(size_t(height) * size_t(row_labels) + 1, 0);
+    std::vector<std::int32_t> first_owned(strip_count);
+    std::int32_t count = 0;
+
+    for (int strip = 0; strip < strip_count; ++strip)
+    {
+        first_owned[strip] = count + 1;
+
+        for (auto label = std::int32_t(strips[strip] * row_labels + 1); label < next[strip]; ++label)
+        {
+            const auto parent = equivalence.parent(label);
+
+            final_labels[label] = parent == label ? ++count : final_labels[parent];
+        }
+    }
+
+    std::vector<component_accumulator> totals(count);
+    std::vector<strip_accumulator> accumulators;
+
+    for (int strip = 0; strip < strip_count; ++strip)
+    {
+        accumulators.emplace_back(totals, first_owned[strip]);
+    }
+
+    for_each_strip(strip_count, [&](int strip)
+    {
+        for (auto y = strips[strip]; y < strips[strip + 1]; ++y)
+        {
+            resolve_row(label_row_ptr(y), y, width, final_labels, accumulators[strip]);
+        }
+    });
+
+    for (auto& accumulator : accumulators)
+    {
+        accumulator.merge();
+    }
+
+    result.components.resize(count);
+
+    for (std::int32_t i = 0; i < count; ++i)
+    {
+        const auto& total = totals[i];
+        auto& component = result.components[i];
+
+        component.area = int(total.area);
+        component.bounds = { location_type{ total.min_x, total.min_y }, location_type{ total.max_x + 1, total.max_y + 1 } };
+        component.centroid = { double(total.sum_x) / total.area, double(total.sum_y) / total.area };
+    }
+
+    return result;
+}
+
+struct label_components_fn
+{
+    component_labeling operator ()(byte_image::const_view_type source, gx::connectivity connectivity = gx::connectivity::eight) const
+    {
+        return label_components(source, connectivity, 1, [](int count, const auto& func)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+        });
+    }
+
+    component_labeling operator ()(const execution::parallel_policy& policy, byte_image::const_view_type source, gx::connectivity connectivity = gx::connectivity::eight) const
+    {
+        static const int min_strip_height = 32;
+
+        const auto strip_count = std::min(int(get_task_count(policy)), std::max(source.height() / min_strip_height, 1));
+
+        return label_components(source, connectivity, strip_count, [&](int count, const auto& func)
+        {
+            parallel_for_bands(policy, count, 1, [&](int begin, int end)
+            {
+                for (auto i = begin; i < end; ++i)
+                {
+                    func(i);
+                }
+            });
+        });
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto label_components = detail::label_components_fn{};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_COMPONENT_LABELING_HPP_ */
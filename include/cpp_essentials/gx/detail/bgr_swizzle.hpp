@@ -0,0 +1,81 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_BGR_SWIZZLE_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_BGR_SWIZZLE_HPP_
+
+#pragma once
+
+#include <cstddef>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* step is the distance in bytes between consecutive source pixels; dst is packed and may alias src when step is 3. */
+inline void swap_red_blue_scalar(const byte* src, std::ptrdiff_t step, byte* dst, int begin, int end)
+{
+    src += begin * step;
+    dst += begin * 3;
+
+    for (int x = begin; x < end; ++x, src += step, dst += 3)
+    {
+        const auto a = src[0];
+        const auto b = src[1];
+        const auto c = src[2];
+
+        dst[0] = c;
+        dst[1] = b;
+        dst[2] = a;
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* Each 128-bit lane swizzles five pixels (15 bytes); the lanes are loaded 15 bytes apart, so one iteration handles ten pixels.
+   The sixteenth byte of a lane passes through unchanged and is overwritten by the following store. */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int swap_red_blue_avx2(const byte* src, byte* dst, int width)
+{
+    const auto shuffle = _mm256_setr_epi8(
+        2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15,
+        2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+
+    int x = 0;
+
+    for (; x + 11 <= width; x += 10, src += 30, dst += 30)
+    {
+        const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 15));
+
+        const auto value = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(value));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 15), _mm256_extracti128_si256(value, 1));
+    }
+
+    return x;
+}
+#endif
+
+/* Converts a row between bgr and rgb order, which is the same swap in both directions. */
+inline void swap_red_blue(const byte* src, std::ptrdiff_t step, byte* dst, int width, simd_level level = get_simd_level())
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2 && step == 3)
+    {
+        x = swap_red_blue_avx2(src, dst, width);
+    }
+#endif
+
+    swap_red_blue_scalar(src, step, dst, x, width);
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_BGR_SWIZZLE_HPP_ */
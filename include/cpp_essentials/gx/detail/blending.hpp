@@ -0,0 +1,276 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_BLENDING_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_BLENDING_HPP_
+
+#pragma once
+
+#include <cpp_essentials/gx/filters.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class blend_mode
+{
+    normal,
+    darker,
+    lighter,
+    multiply,
+    screen,
+    overlay,
+    difference,
+    add,
+    subtract
+};
+
+namespace detail
+{
+
+/* The scalar path uses the per-value filters, so the row kernels reproduce them exactly. */
+template <class Filter>
+void blend_row_scalar(const Filter& filter, const byte* lhs, const byte* rhs, byte* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        dst[i] = filter(lhs[i], rhs[i]);
+    }
+}
+
+/* round((blended * mask + lhs * (255 - mask)) / 255); the sum plus 128 fits 16 bits and (t + (t >> 8)) >> 8 divides it exactly */
+inline void mix_row_scalar(const byte* lhs, const byte* blended, const byte* mask, byte* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        const auto t = blended[i] * mask[i] + lhs[i] * (255 - mask[i]) + 128;
+        dst[i] = byte((t + (t >> 8)) >> 8);
+    }
+}
+
+/* the same mix with one weight for the whole row, which is how filters::blend's ratio is applied */
+inline void mix_row_scalar(const byte* lhs, const byte* rhs, byte weight, byte* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        const auto t = rhs[i] * weight + lhs[i] * (255 - weight) + 128;
+        dst[i] = byte((t + (t >> 8)) >> 8);
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* Modes built from products are evaluated on bytes widened to 16 bits; unpack and pack both work within 128-bit lanes,
+   so the packed result is in order. */
+template <blend_mode Mode>
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256i blend_widened_avx2(__m256i lhs, __m256i rhs)
+{
+    const auto max = _mm256_set1_epi16(255);
+
+    if constexpr (Mode == blend_mode::multiply)
+    {
+        return div255_epu16(_mm256_mullo_epi16(lhs, rhs));
+    }
+    else if constexpr (Mode == blend_mode::screen)
+    {
+        return _mm256_sub_epi16(max, div255_epu16(_mm256_mullo_epi16(_mm256_sub_epi16(max, lhs), _mm256_sub_epi16(max, rhs))));
+    }
+    else
+    {
+        /* overlay: both branches are computed and selected by lhs > 128; 2 * lhs * rhs / 255 may reach 256, which pack saturates */
+        const auto dark = div255_epu16(_mm256_slli_epi16(_mm256_mullo_epi16(lhs, rhs), 1));
+        const auto light = _mm256_sub_epi16(max,
+            div255_epu16(_mm256_slli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(max, lhs), _mm256_sub_epi16(max, rhs)), 1)));
+
+        return _mm256_blendv_epi8(dark, light, _mm256_cmpgt_epi16(lhs, _mm256_set1_epi16(128)));
+    }
+}
+
+template <blend_mode Mode>
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256i blend_avx2(__m256i lhs, __m256i rhs)
+{
+    if constexpr (Mode == blend_mode::normal)
+    {
+        return rhs;
+    }
+    else if constexpr (Mode == blend_mode::darker)
+    {
+        return _mm256_min_epu8(lhs, rhs);
+    }
+    else if constexpr (Mode == blend_mode::lighter)
+    {
+        return _mm256_max_epu8(lhs, rhs);
+    }
+    else if constexpr (Mode == blend_mode::difference)
+    {
+        return _mm256_or_si256(_mm256_subs_epu8(lhs, rhs), _mm256_subs_epu8(rhs, lhs));
+    }
+    else if constexpr (Mode == blend_mode::add)
+    {
+        return _mm256_adds_epu8(lhs, rhs);
+    }
+    else if constexpr (Mode == blend_mode::subtract)
+    {
+        /* lhs + rhs - 255 == lhs - (255 - rhs), saturated at zero */
+        return _mm256_subs_epu8(lhs, _mm256_xor_si256(rhs, _mm256_set1_epi8(-1)));
+    }
+    else
+    {
+        const auto zero = _mm256_setzero_si256();
+
+        const auto lo = blend_widened_avx2<Mode>(_mm256_unpacklo_epi8(lhs, zero), _mm256_unpacklo_epi8(rhs, zero));
+        const auto hi = blend_widened_avx2<Mode>(_mm256_unpackhi_epi8(lhs, zero), _mm256_unpackhi_epi8(rhs, zero));
+
+        return _mm256_packus_epi16(lo, hi);
+    }
+}
+
+template <blend_mode Mode>
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int blend_row_avx2(const byte* lhs, const byte* rhs, byte* dst, int count)
+{
+    int i = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blend_avx2<Mode>(l, r));
+    }
+
+    return i;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256i mix_widened_avx2(__m256i lhs, __m256i blended, __m256i mask)
+{
+    const auto t = _mm256_add_epi16(
+        _mm256_add_epi16(_mm256_mullo_epi16(blended, mask), _mm256_mullo_epi16(lhs, _mm256_sub_epi16(_mm256_set1_epi16(255), mask))),
+        _mm256_set1_epi16(128));
+
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int mix_row_avx2(const byte* lhs, const byte* blended, const byte* mask, byte* dst, int count)
+{
+    const auto zero = _mm256_setzero_si256();
+
+    int i = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blended + i));
+        const auto m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i));
+
+        const auto lo = mix_widened_avx2(_mm256_unpacklo_epi8(l, zero), _mm256_unpacklo_epi8(b, zero), _mm256_unpacklo_epi8(m, zero));
+        const auto hi = mix_widened_avx2(_mm256_unpackhi_epi8(l, zero), _mm256_unpackhi_epi8(b, zero), _mm256_unpackhi_epi8(m, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int mix_row_avx2(const byte* lhs, const byte* rhs, byte weight, byte* dst, int count)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto w = _mm256_set1_epi16(weight);
+
+    int i = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+
+        const auto lo = mix_widened_avx2(_mm256_unpacklo_epi8(l, zero), _mm256_unpacklo_epi8(r, zero), w);
+        const auto hi = mix_widened_avx2(_mm256_unpackhi_epi8(l, zero), _mm256_unpackhi_epi8(r, zero), w);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+#endif
+
+template <blend_mode Mode, class Filter>
+void blend_row(const Filter& filter, const byte* lhs, const byte* rhs, byte* dst, int count, simd_level level)
+{
+    int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        i = blend_row_avx2<Mode>(lhs, rhs, dst, count);
+    }
+#endif
+
+    blend_row_scalar(filter, lhs, rhs, dst, i, count);
+}
+
+/* count is the number of bytes of a contiguous row */
+inline void blend_row(blend_mode mode, const byte* lhs, const byte* rhs, byte* dst, int count, simd_level level = get_simd_level())
+{
+    switch (mode)
+    {
+        case blend_mode::normal: return blend_row<blend_mode::normal>(filters::normal{}, lhs, rhs, dst, count, level);
+        case blend_mode::darker: return blend_row<blend_mode::darker>(filters::darker{}, lhs, rhs, dst, count, level);
+        case blend_mode::lighter: return blend_row<blend_mode::lighter>(filters::lighter{}, lhs, rhs, dst, count, level);
+        case blend_mode::multiply: return blend_row<blend_mode::multiply>(filters::multiply{}, lhs, rhs, dst, count, level);
+        case blend_mode::screen: return blend_row<blend_mode::screen>(filters::screen{}, lhs, rhs, dst, count, level);
+        case blend_mode::overlay: return blend_row<blend_mode::overlay>(filters::overlay{}, lhs, rhs, dst, count, level);
+        case blend_mode::difference: return blend_row<blend_mode::difference>(filters::difference{}, lhs, rhs, dst, count, level);
+        case blend_mode::add: return blend_row<blend_mode::add>(filters::add{}, lhs, rhs, dst, count, level);
+        case blend_mode::subtract: return blend_row<blend_mode::subtract>(filters::subtract{}, lhs, rhs, dst, count, level);
+    }
+}
+
+inline void mix_row(const byte* lhs, const byte* blended, const byte* mask, byte* dst, int count, simd_level level = get_simd_level())
+{
+    int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        i = mix_row_avx2(lhs, blended, mask, dst, count);
+    }
+#endif
+
+    mix_row_scalar(lhs, blended, mask, dst, i, count);
+}
+
+inline void mix_row(const byte* lhs, const byte* rhs, byte weight, byte* dst, int count, simd_level level = get_simd_level())
+{
+    int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        i = mix_row_avx2(lhs, rhs, weight, dst, count);
+    }
+#endif
+
+    mix_row_scalar(lhs, rhs, weight, dst, i, count);
+}
+
+/* repeats each mask value for every channel of its pixel */
+template <size_t Channels>
+void expand_mask_row(const byte* mask, byte* dst, int width)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[x * Channels + c] = mask[x];
+        }
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_BLENDING_HPP_ */
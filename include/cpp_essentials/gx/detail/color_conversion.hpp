@@ -0,0 +1,544 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_COLOR_CONVERSION_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_COLOR_CONVERSION_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include <cpp_essentials/gx/color_models.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* Branchless float versions of the per-pixel conversions in color_models.hpp, using the same units: hue in degrees, other
+   hsv / hsl / cmyk channels in [0, 1], yuv / yiq in the scale of the byte input. Every conversion has a scalar overload and
+   an AVX2 overload performing the same operations in the same order, so both paths give identical results. */
+
+inline float select(bool mask, float a, float b)
+{
+    return mask ? a : b;
+}
+
+/* hue sector shared by hsv and hsl */
+inline float get_hue(float r, float g, float b, float max, float span)
+{
+    const auto is_r = max == r;
+    const auto is_g = max == g;
+
+    const auto num = select(is_r, g - b, select(is_g, b - r, r - g));
+    const auto offset = select(is_r, 0.F, select(is_g, 2.F, 4.F));
+    const auto h = 60.F * (num / select(span == 0.F, 1.F, span) + offset);
+
+    return select(h < 0.F, h + 360.F, h);
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256 select(__m256 mask, __m256 a, __m256 b)
+{
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256 get_hue(__m256 r, __m256 g, __m256 b, __m256 max, __m256 span)
+{
+    const auto zero = _mm256_setzero_ps();
+    const auto is_r = _mm256_cmp_ps(max, r, _CMP_EQ_OQ);
+    const auto is_g = _mm256_cmp_ps(max, g, _CMP_EQ_OQ);
+
+    const auto num = select(is_r, _mm256_sub_ps(g, b), select(is_g, _mm256_sub_ps(b, r), _mm256_sub_ps(r, g)));
+    const auto offset = select(is_r, zero, select(is_g, _mm256_set1_ps(2.F), _mm256_set1_ps(4.F)));
+    const auto den = select(_mm256_cmp_ps(span, zero, _CMP_EQ_OQ), _mm256_set1_ps(1.F), span);
+    const auto h = _mm256_mul_ps(_mm256_set1_ps(60.F), _mm256_add_ps(_mm256_div_ps(num, den), offset));
+
+    return select(_mm256_cmp_ps(h, zero, _CMP_LT_OQ), _mm256_add_ps(h, _mm256_set1_ps(360.F)), h);
+}
+#endif
+
+struct hsv_conversion
+{
+    static constexpr size_t channels = 3;
+
+    void forward(const float* rgb, float* out) const
+    {
+        const auto r = rgb[0] * (1.F / 255.F);
+        const auto g = rgb[1] * (1.F / 255.F);
+        const auto b = rgb[2] * (1.F / 255.F);
+
+        const auto max = std::max(r, std::max(g, b));
+        const auto span = max - std::min(r, std::min(g, b));
+
+        out[0] = get_hue(r, g, b, max, span);
+        out[1] = span / select(max == 0.F, 1.F, max);
+        out[2] = max;
+    }
+
+    /* v - v * s * clamp(min(k, 4 - k), 0, 1) with k = (n + h / 60) mod 6 for n = 5, 3, 1 */
+    void backward(const float* in, float* rgb) const
+    {
+        const auto x = in[0] * (1.F / 60.F);
+        const auto vs = in[2] * in[1];
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto k = float(5 - 2 * c) + x;
+            k = k - 6.F * std::floor(k * (1.F / 6.F));
+
+            rgb[c] = (in[2] - vs * std::max(0.F, std::min(std::min(k, 4.F - k), 1.F))) * 255.F;
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void forward(const __m256* rgb, __m256* out) const
+    {
+        const auto scale = _mm256_set1_ps(1.F / 255.F);
+
+        const auto r = _mm256_mul_ps(rgb[0], scale);
+        const auto g = _mm256_mul_ps(rgb[1], scale);
+        const auto b = _mm256_mul_ps(rgb[2], scale);
+
+        const auto max = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const auto span = _mm256_sub_ps(max, _mm256_min_ps(r, _mm256_min_ps(g, b)));
+
+        out[0] = get_hue(r, g, b, max, span);
+        out[1] = _mm256_div_ps(span, select(_mm256_cmp_ps(max, _mm256_setzero_ps(), _CMP_EQ_OQ), _mm256_set1_ps(1.F), max));
+        out[2] = max;
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void backward(const __m256* in, __m256* rgb) const
+    {
+        const auto x = _mm256_mul_ps(in[0], _mm256_set1_ps(1.F / 60.F));
+        const auto vs = _mm256_mul_ps(in[2], in[1]);
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto k = _mm256_add_ps(_mm256_set1_ps(float(5 - 2 * c)), x);
+            k = _mm256_sub_ps(k, _mm256_mul_ps(_mm256_set1_ps(6.F), _mm256_floor_ps(_mm256_mul_ps(k, _mm256_set1_ps(1.F / 6.F)))));
+
+            const auto t = _mm256_max_ps(_mm256_setzero_ps(), _mm256_min_ps(_mm256_min_ps(k, _mm256_sub_ps(_mm256_set1_ps(4.F), k)), _mm256_set1_ps(1.F)));
+
+            rgb[c] = _mm256_mul_ps(_mm256_sub_ps(in[2], _mm256_mul_ps(vs, t)), _mm256_set1_ps(255.F));
+        }
+    }
+#endif
+};
+
+struct hsl_conversion
+{
+    static constexpr size_t channels = 3;
+
+    void forward(const float* rgb, float* out) const
+    {
+        const auto r = rgb[0] * (1.F / 255.F);
+        const auto g = rgb[1] * (1.F / 255.F);
+        const auto b = rgb[2] * (1.F / 255.F);
+
+        const auto max = std::max(r, std::max(g, b));
+        const auto min = std::min(r, std::min(g, b));
+        const auto span = max - min;
+        const auto sum = max + min;
+        const auto l = sum * 0.5F;
+
+        out[0] = get_hue(r, g, b, max, span);
+        out[1] = span / select(span == 0.F, 1.F, select(l <= 0.5F, sum, 2.F - sum));
+        out[2] = l;
+    }
+
+    /* l - a * clamp(min(k - 3, 9 - k), -1, 1) with a = s * min(l, 1 - l) and k = (n + h / 30) mod 12 for n = 0, 8, 4 */
+    void backward(const float* in, float* rgb) const
+    {
+        const auto x = in[0] * (1.F / 30.F);
+        const auto a = in[1] * std::min(in[2], 1.F - in[2]);
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto k = float((12 - 4 * c) % 12) + x;
+            k = k - 12.F * std::floor(k * (1.F / 12.F));
+
+            rgb[c] = (in[2] - a * std::max(-1.F, std::min(std::min(k - 3.F, 9.F - k), 1.F))) * 255.F;
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void forward(const __m256* rgb, __m256* out) const
+    {
+        const auto scale = _mm256_set1_ps(1.F / 255.F);
+        const auto one = _mm256_set1_ps(1.F);
+
+        const auto r = _mm256_mul_ps(rgb[0], scale);
+        const auto g = _mm256_mul_ps(rgb[1], scale);
+        const auto b = _mm256_mul_ps(rgb[2], scale);
+
+        const auto max = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const auto min = _mm256_min_ps(r, _mm256_min_ps(g, b));
+        const auto span = _mm256_sub_ps(max, min);
+        const auto sum = _mm256_add_ps(max, min);
+        const auto l = _mm256_mul_ps(sum, _mm256_set1_ps(0.5F));
+
+        const auto den = select(
+            _mm256_cmp_ps(span, _mm256_setzero_ps(), _CMP_EQ_OQ),
+            one,
+            select(_mm256_cmp_ps(l, _mm256_set1_ps(0.5F), _CMP_LE_OQ), sum, _mm256_sub_ps(_mm256_set1_ps(2.F), sum)));
+
+        out[0] = get_hue(r, g, b, max, span);
+        out[1] = _mm256_div_ps(span, den);
+        out[2] = l;
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void backward(const __m256* in, __m256* rgb) const
+    {
+        const auto x = _mm256_mul_ps(in[0], _mm256_set1_ps(1.F / 30.F));
+        const auto a = _mm256_mul_ps(in[1], _mm256_min_ps(in[2], _mm256_sub_ps(_mm256_set1_ps(1.F), in[2])));
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto k = _mm256_add_ps(_mm256_set1_ps(float((12 - 4 * c) % 12)), x);
+            k = _mm256_sub_ps(k, _mm256_mul_ps(_mm256_set1_ps(12.F), _mm256_floor_ps(_mm256_mul_ps(k, _mm256_set1_ps(1.F / 12.F)))));
+
+            const auto t = _mm256_max_ps(
+                _mm256_set1_ps(-1.F),
+                _mm256_min_ps(_mm256_min_ps(_mm256_sub_ps(k, _mm256_set1_ps(3.F)), _mm256_sub_ps(_mm256_set1_ps(9.F), k)), _mm256_set1_ps(1.F)));
+
+            rgb[c] = _mm256_mul_ps(_mm256_sub_ps(in[2], _mm256_mul_ps(a, t)), _mm256_set1_ps(255.F));
+        }
+    }
+#endif
+};
+
+struct cmyk_conversion
+{
+    static constexpr size_t channels = 4;
+
+    void forward(const float* rgb, float* out) const
+    {
+        const auto c = 1.F - rgb[0] * (1.F / 255.F);
+        const auto m = 1.F - rgb[1] * (1.F / 255.F);
+        const auto y = 1.F - rgb[2] * (1.F / 255.F);
+        const auto k = std::min(c, std::min(m, y));
+        const auto den = select(k == 1.F, 1.F, 1.F - k);
+
+        out[0] = (c - k) / den;
+        out[1] = (m - k) / den;
+        out[2] = (y - k) / den;
+        out[3] = k;
+    }
+
+    void backward(const float* in, float* rgb) const
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            rgb[c] = (1.F - in[c]) * (1.F - in[3]) * 255.F;
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void forward(const __m256* rgb, __m256* out) const
+    {
+        const auto one = _mm256_set1_ps(1.F);
+        const auto scale = _mm256_set1_ps(1.F / 255.F);
+
+        const auto c = _mm256_sub_ps(one, _mm256_mul_ps(rgb[0], scale));
+        const auto m = _mm256_sub_ps(one, _mm256_mul_ps(rgb[1], scale));
+        const auto y = _mm256_sub_ps(one, _mm256_mul_ps(rgb[2], scale));
+        const auto k = _mm256_min_ps(c, _mm256_min_ps(m, y));
+        const auto den = select(_mm256_cmp_ps(k, one, _CMP_EQ_OQ), one, _mm256_sub_ps(one, k));
+
+        out[0] = _mm256_div_ps(_mm256_sub_ps(c, k), den);
+        out[1] = _mm256_div_ps(_mm256_sub_ps(m, k), den);
+        out[2] = _mm256_div_ps(_mm256_sub_ps(y, k), den);
+        out[3] = k;
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void backward(const __m256* in, __m256* rgb) const
+    {
+        const auto one = _mm256_set1_ps(1.F);
+
+        for (int c = 0; c < 3; ++c)
+        {
+            rgb[c] = _mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(one, in[c]), _mm256_sub_ps(one, in[3])), _mm256_set1_ps(255.F));
+        }
+    }
+#endif
+};
+
+/* Linear spaces; the coefficients follow the row-vector convention of to_yiq / to_yuv. */
+struct matrix_conversion
+{
+    static constexpr size_t channels = 3;
+
+    using matrix_type = std::array<std::array<float, 3>, 3>;
+
+    explicit matrix_conversion(const geo::square_matrix<double, 3>& matrix)
+        : _forward(make_coefficients(matrix))
+        , _backward(make_coefficients(geo::invert(matrix).value()))
+    {
+    }
+
+    void forward(const float* rgb, float* out) const
+    {
+        apply(_forward, rgb, out);
+    }
+
+    void backward(const float* in, float* rgb) const
+    {
+        apply(_backward, in, rgb);
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void forward(const __m256* rgb, __m256* out) const
+    {
+        apply(_forward, rgb, out);
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void backward(const __m256* in, __m256* rgb) const
+    {
+        apply(_backward, in, rgb);
+    }
+#endif
+
+private:
+    static matrix_type make_coefficients(const geo::square_matrix<double, 3>& matrix)
+    {
+        matrix_type result;
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            geo::vector<double, 3> unit{ 0.0, 0.0, 0.0 };
+            unit[i] = 1.0;
+
+            const auto column = unit * matrix;
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                result[j][i] = float(column[j]);
+            }
+        }
+
+        return result;
+    }
+
+    static void apply(const matrix_type& m, const float* in, float* out)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            out[j] = m[j][0] * in[0] + m[j][1] * in[1] + m[j][2] * in[2];
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    static void apply(const matrix_type& m, const __m256* in, __m256* out)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            out[j] = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[j][0]), in[0]), _mm256_mul_ps(_mm256_set1_ps(m[j][1]), in[1])),
+                _mm256_mul_ps(_mm256_set1_ps(m[j][2]), in[2]));
+        }
+    }
+#endif
+
+    matrix_type _forward;
+    matrix_type _backward;
+};
+
+/* Rotates the hue and scales the saturation in hsv without leaving registers. */
+struct hue_saturation_adjustment
+{
+    float hue_shift;
+    float saturation_scale;
+
+    void operator ()(const float* rgb, float* out) const
+    {
+        float hsv[3];
+        hsv_conversion{}.forward(rgb, hsv);
+
+        hsv[0] += hue_shift;
+        hsv[1] = std::min(hsv[1] * saturation_scale, 1.F);
+
+        hsv_conversion{}.backward(hsv, out);
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void operator ()(const __m256* rgb, __m256* out) const
+    {
+        __m256 hsv[3];
+        hsv_conversion{}.forward(rgb, hsv);
+
+        hsv[0] = _mm256_add_ps(hsv[0], _mm256_set1_ps(hue_shift));
+        hsv[1] = _mm256_min_ps(_mm256_mul_ps(hsv[1], _mm256_set1_ps(saturation_scale)), _mm256_set1_ps(1.F));
+
+        hsv_conversion{}.backward(hsv, out);
+    }
+#endif
+};
+
+/* Adapt a conversion to the func(in, out) form taken by transform_planes. */
+template <class Conversion>
+struct forward_conversion
+{
+    const Conversion& conversion;
+
+    void operator ()(const float* in, float* out) const
+    {
+        conversion.forward(in, out);
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void operator ()(const __m256* in, __m256* out) const
+    {
+        conversion.forward(in, out);
+    }
+#endif
+};
+
+template <class Conversion>
+struct backward_conversion
+{
+    const Conversion& conversion;
+
+    void operator ()(const float* in, float* out) const
+    {
+        conversion.backward(in, out);
+    }
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    void operator ()(const __m256* in, __m256* out) const
+    {
+        conversion.backward(in, out);
+    }
+#endif
+};
+
+inline byte to_channel(float value)
+{
+    return byte(std::min(std::max(value + 0.5F, 0.F), 255.F));
+}
+
+/* The row kernels below read and write planar rows: bytes on the rgb side, floats on the converted side. */
+template <class Func, size_t In, size_t Out, class Src, class Dst>
+void transform_planes_scalar(const Func& func, const std::array<const Src*, In>& src, const std::array<Dst*, Out>& dst, int begin, int end)
+{
+    for (int x = begin; x < end; ++x)
+    {
+        float in[In];
+        float out[Out];
+
+        for (size_t c = 0; c < In; ++c)
+        {
+            in[c] = float(src[c][x]);
+        }
+
+        func(in, out);
+
+        for (size_t c = 0; c < Out; ++c)
+        {
+            if constexpr (std::is_same_v<Dst, byte>)
+            {
+                dst[c][x] = to_channel(out[c]);
+            }
+            else
+            {
+                dst[c][x] = out[c];
+            }
+        }
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256 load_plane(const byte* ptr)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr))));
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256 load_plane(const float* ptr)
+{
+    return _mm256_loadu_ps(ptr);
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline void store_plane(__m256 value, byte* ptr)
+{
+    const auto clamped = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(value, _mm256_set1_ps(0.5F)), _mm256_setzero_ps()), _mm256_set1_ps(255.F));
+    const auto ints = _mm256_cvttps_epi32(clamped);
+    const auto words = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr), _mm_packus_epi16(words, words));
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline void store_plane(__m256 value, float* ptr)
+{
+    _mm256_storeu_ps(ptr, value);
+}
+
+template <class Func, size_t In, size_t Out, class Src, class Dst>
+CPP_ESSENTIALS_GX_TARGET("avx2")
+int transform_planes_avx2(const Func& func, const std::array<const Src*, In>& src, const std::array<Dst*, Out>& dst, int width)
+{
+    int x = 0;
+
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 in[In];
+        __m256 out[Out];
+
+        for (size_t c = 0; c < In; ++c)
+        {
+            in[c] = load_plane(src[c] + x);
+        }
+
+        func(in, out);
+
+        for (size_t c = 0; c < Out; ++c)
+        {
+            store_plane(out[c], dst[c] + x);
+        }
+    }
+
+    return x;
+}
+#endif
+
+template <class Func, size_t In, size_t Out, class Src, class Dst>
+void transform_planes(const Func& func, const std::array<const Src*, In>& src, const std::array<Dst*, Out>& dst, int width, simd_level level)
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        x = transform_planes_avx2(func, src, dst, width);
+    }
+#endif
+
+    transform_planes_scalar(func, src, dst, x, width);
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_COLOR_CONVERSION_HPP_ */
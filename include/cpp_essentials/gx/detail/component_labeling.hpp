@@ -0,0 +1,244 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_COMPONENT_LABELING_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_COMPONENT_LABELING_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* Union-find over provisional labels. The smaller label always becomes the root, so parent[l] <= l, and roots follow the
+   order in which labels were created. */
+class label_equivalence
+{
+public:
+    explicit label_equivalence(size_t count)
+        : _parent(count, 0)
+    {
+    }
+
+    std::int32_t make(std::int32_t label)
+    {
+        _parent[label] = label;
+        return label;
+    }
+
+    std::int32_t parent(std::int32_t label) const
+    {
+        return _parent[label];
+    }
+
+    /* with path halving */
+    std::int32_t find(std::int32_t label)
+    {
+        while (_parent[label] != label)
+        {
+            _parent[label] = _parent[_parent[label]];
+            label = _parent[label];
+        }
+
+        return label;
+    }
+
+    std::int32_t merge(std::int32_t lhs, std::int32_t rhs)
+    {
+        lhs = find(lhs);
+        rhs = find(rhs);
+
+        if (lhs < rhs)
+        {
+            _parent[rhs] = lhs;
+            return lhs;
+        }
+
+        _parent[lhs] = rhs;
+        return rhs;
+    }
+
+private:
+    std::vector<std::int32_t> _parent;
+};
+
+/* First pass over one row: every run of foreground pixels gets one provisional label, joined with the labels of the row above
+   within `reach` pixels of the run (0 for 4-connectivity, 1 for 8-connectivity). above is null for the first row. */
+inline void label_row(const byte* row, const std::int32_t* above, std::int32_t* labels, int width, int reach, label_equivalence& equivalence, std::int32_t& next)
+{
+    for (int x = 0; x < width; )
+    {
+        if (row[x] == 0)
+        {
+            labels[x++] = 0;
+            continue;
+        }
+
+        auto end = x + 1;
+
+        while (end < width && row[end] != 0)
+        {
+            ++end;
+        }
+
+        std::int32_t label = 0;
+
+        if (above)
+        {
+            const auto lower = std::max(x - reach, 0);
+            const auto upper = std::min(end + reach, width);
+
+            for (auto i = lower; i < upper; ++i)
+            {
+                if (above[i] != 0 && (i == lower || above[i] != above[i - 1]))
+                {
+                    label = label != 0 ? equivalence.merge(label, above[i]) : equivalence.find(above[i]);
+                }
+            }
+        }
+
+        if (label == 0)
+        {
+            label = equivalence.make(next++);
+        }
+
+        std::fill(labels + x, labels + end, label);
+        x = end;
+    }
+}
+
+/* Joins the labels of a row that was labeled without its upper neighbour, i.e. the first row of a strip. */
+inline void merge_row(const std::int32_t* above, const std::int32_t* labels, int width, int reach, label_equivalence& equivalence)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        if (labels[x] == 0)
+        {
+            continue;
+        }
+
+        for (auto i = std::max(x - reach, 0); i <= std::min(x + reach, width - 1); ++i)
+        {
+            if (above[i] != 0)
+            {
+                equivalence.merge(labels[x], above[i]);
+            }
+        }
+    }
+}
+
+struct component_accumulator
+{
+    long long area = 0;
+    long long sum_x = 0;
+    long long sum_y = 0;
+    int min_x = INT_MAX;
+    int min_y = INT_MAX;
+    int max_x = INT_MIN;
+    int max_y = INT_MIN;
+
+    void add_run(int y, int x_begin, int x_end)
+    {
+        const long long count = x_end - x_begin;
+
+        area += count;
+        sum_x += count * (x_begin + x_end - 1) / 2;
+        sum_y += count * y;
+        min_x = std::min(min_x, x_begin);
+        max_x = std::max(max_x, x_end - 1);
+        min_y = std::min(min_y, y);
+        max_y = std::max(max_y, y);
+    }
+
+    void add(const component_accumulator& other)
+    {
+        area += other.area;
+        sum_x += other.sum_x;
+        sum_y += other.sum_y;
+        min_x = std::min(min_x, other.min_x);
+        min_y = std::min(min_y, other.min_y);
+        max_x = std::max(max_x, other.max_x);
+        max_y = std::max(max_y, other.max_y);
+    }
+};
+
+/* Statistics gathered by the second pass of one strip. Components whose root label lies in the strip, final labels from
+   first_owned on, are added straight into the shared array, where no other strip writes; the few that started in an earlier
+   strip and cross into this one are kept aside until the strips are merged. */
+class strip_accumulator
+{
+public:
+    strip_accumulator(std::vector<component_accumulator>& components, std::int32_t first_owned)
+        : _components(components)
+        , _first_owned(first_owned)
+    {
+    }
+
+    void add_run(std::int32_t label, int y, int x_begin, int x_end)
+    {
+        if (label >= _first_owned)
+        {
+            _components[label - 1].add_run(y, x_begin, x_end);
+        }
+        else
+        {
+            _foreign[label].add_run(y, x_begin, x_end);
+        }
+    }
+
+    void merge()
+    {
+        for (const auto& [label, accumulator] : _foreign)
+        {
+            _components[label - 1].add(accumulator);
+        }
+
+        _foreign.clear();
+    }
+
+private:
+    std::vector<component_accumulator>& _components;
+    std::int32_t _first_owned;
+    std::unordered_map<std::int32_t, component_accumulator> _foreign;
+};
+
+/* Second pass over one row: provisional labels are replaced with final ones and the runs are added to the statistics. */
+inline void resolve_row(std::int32_t* labels, int y, int width, const std::vector<std::int32_t>& final_labels, strip_accumulator& components)
+{
+    for (int x = 0; x < width; )
+    {
+        const auto provisional = labels[x];
+
+        if (provisional == 0)
+        {
+            ++x;
+            continue;
+        }
+
+        auto end = x + 1;
+
+        while (end < width && labels[end] == provisional)
+        {
+            ++end;
+        }
+
+        const auto label = final_labels[provisional];
+
+        std::fill(labels + x, labels + end, label);
+        components.add_run(label, y, x, end);
+        x = end;
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_COMPONENT_LABELING_HPP_ */
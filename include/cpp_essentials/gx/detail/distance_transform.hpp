@@ -0,0 +1,136 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_DISTANCE_TRANSFORM_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_DISTANCE_TRANSFORM_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* First phase, for columns [begin, end): the distance along the column to the nearest feature pixel, or infinity. The sweeps
+   go row by row, so the inner loops run over contiguous memory. */
+inline void column_distances(byte_image::const_view_type source, image<float>& dest, bool feature_is_zero, int begin, int end)
+{
+    const auto infinity = std::numeric_limits<float>::infinity();
+    const auto height = source.height();
+    const auto step = source.stride()[0];
+
+    for (int y = 0; y < height; ++y)
+    {
+        const auto* src = reinterpret_cast<const byte*>(source.data({ begin, y }));
+        auto* dst = dest.data({ 0, y });
+        const auto* above = y > 0 ? dest.data({ 0, y - 1 }) : nullptr;
+
+        for (auto x = begin; x < end; ++x, src += step)
+        {
+            const auto feature = (*src == 0) == feature_is_zero;
+
+            dst[x] = feature ? 0.F : above ? above[x] + 1.F : infinity;
+        }
+    }
+
+    for (auto y = height - 2; y >= 0; --y)
+    {
+        auto* dst = dest.data({ 0, y });
+        const auto* below = dest.data({ 0, y + 1 });
+
+        for (auto x = begin; x < end; ++x)
+        {
+            dst[x] = std::min(dst[x], below[x] + 1.F);
+        }
+    }
+}
+
+/* Scratch space of the one-dimensional transform for rows of up to `size` samples. */
+struct lower_envelope
+{
+    std::vector<double> values;
+    std::vector<int> vertices;
+    std::vector<double> bounds;
+
+    explicit lower_envelope(int size)
+        : values(size)
+        , vertices(size)
+        , bounds(size + 1)
+    {
+    }
+};
+
+/* Second phase (Felzenszwalb and Huttenlocher): the row holds column distances g, and is replaced with
+   sqrt(min over q of (x - q)^2 + g(q)^2), computed from the lower envelope of the parabolas rooted at the finite samples. */
+inline void row_distances(float* row, int width, lower_envelope& envelope)
+{
+    auto* f = envelope.values.data();
+    auto* v = envelope.vertices.data();
+    auto* z = envelope.bounds.data();
+
+    int k = -1;
+
+    for (int q = 0; q < width; ++q)
+    {
+        if (std::isinf(row[q]))
+        {
+            continue;
+        }
+
+        f[q] = double(row[q]) * double(row[q]);
+
+        double s = -std::numeric_limits<double>::infinity();
+
+        while (k >= 0)
+        {
+            const auto p = v[k];
+
+            s = ((f[q] + double(q) * q) - (f[p] + double(p) * p)) / (2.0 * (q - p));
+
+            if (s > z[k])
+            {
+                break;
+            }
+
+            --k;
+        }
+
+        if (k < 0)
+        {
+            s = -std::numeric_limits<double>::infinity();
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    if (k < 0)
+    {
+        return;
+    }
+
+    for (int q = 0, j = 0; q < width; ++q)
+    {
+        while (z[j + 1] < q)
+        {
+            ++j;
+        }
+
+        const auto dx = double(q - v[j]);
+
+        row[q] = float(std::sqrt(dx * dx + f[v[j]]));
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_DISTANCE_TRANSFORM_HPP_ */
@@ -0,0 +1,237 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_FIXED_POINT_CONVOLUTION_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_FIXED_POINT_CONVOLUTION_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <cpp_essentials/core/optional.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* Kernel with taps equal to integer / 2^shift; results are (sum of value * tap) >> shift. */
+struct fixed_point_kernel_t
+{
+    std::vector<std::int16_t> taps;
+    size_type size;
+    int shift;
+    int magnitude;
+
+    /* Every partial sum stays within int16 lanes. */
+    bool fits_int16() const
+    {
+        return magnitude * 255 <= std::numeric_limits<std::int16_t>::max();
+    }
+};
+
+static constexpr int max_fixed_point_shift = 8;
+
+/* Largest sum of absolute taps for which every partial sum of byte values stays below 2^24. */
+static constexpr int max_fixed_point_magnitude = (1 << 24) / 255;
+
+/* Only kernels which are represented exactly are quantized: with all partial sums below 2^24 the float path is exact as well, so both paths agree bit for bit. */
+inline core::optional<fixed_point_kernel_t> make_fixed_point(const kernel_type& kernel)
+{
+    for (int shift = 0; shift <= max_fixed_point_shift; ++shift)
+    {
+        const auto scale = float(1 << shift);
+
+        fixed_point_kernel_t result{ {}, kernel.size(), shift, 0 };
+
+        bool exact = true;
+
+        for (auto tap : kernel)
+        {
+            const auto scaled = tap * scale;
+
+            if (scaled != std::trunc(scaled) || std::abs(scaled) > std::numeric_limits<std::int16_t>::max())
+            {
+                exact = false;
+                break;
+            }
+
+            result.taps.push_back(std::int16_t(scaled));
+            result.magnitude += std::abs(int(scaled));
+
+            /* larger shifts only scale the taps up, so no shift fits either */
+            if (result.magnitude > max_fixed_point_magnitude)
+            {
+                return {};
+            }
+        }
+
+        if (exact)
+        {
+            return result;
+        }
+    }
+
+    return {};
+}
+
+struct fixed_point_row_fn
+{
+    const byte* const* rows;
+    const fixed_point_kernel_t& kernel;
+
+    void scalar(byte* out, int begin, int end) const
+    {
+        const auto width = kernel.size.x();
+        const auto height = kernel.size.y();
+
+        for (int x = begin; x < end; ++x)
+        {
+            std::int32_t sum = 0;
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    sum += rows[j][x + i] * kernel.taps[j * width + i];
+                }
+            }
+
+            out[x] = byte(std::min(std::max(sum >> kernel.shift, 0), 255));
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+    int sse2(byte* out, int x, int end) const
+    {
+        const auto width = kernel.size.x();
+        const auto height = kernel.size.y();
+        const auto zero = _mm_setzero_si128();
+        const auto shift = _mm_cvtsi32_si128(kernel.shift);
+
+        for (; x + 16 <= end; x += 16)
+        {
+            auto lo_sum = zero;
+            auto hi_sum = zero;
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    const auto tap = _mm_set1_epi16(kernel.taps[j * width + i]);
+                    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[j] + x + i));
+
+                    lo_sum = _mm_add_epi16(lo_sum, _mm_mullo_epi16(_mm_unpacklo_epi8(value, zero), tap));
+                    hi_sum = _mm_add_epi16(hi_sum, _mm_mullo_epi16(_mm_unpackhi_epi8(value, zero), tap));
+                }
+            }
+
+            const auto packed = _mm_packus_epi16(_mm_sra_epi16(lo_sum, shift), _mm_sra_epi16(hi_sum, shift));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), packed);
+        }
+
+        return x;
+    }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    int avx2(byte* out, int x, int end) const
+    {
+        const auto width = kernel.size.x();
+        const auto height = kernel.size.y();
+        const auto zero = _mm256_setzero_si256();
+        const auto shift = _mm_cvtsi32_si128(kernel.shift);
+
+        for (; x + 32 <= end; x += 32)
+        {
+            auto lo_sum = zero;
+            auto hi_sum = zero;
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    const auto tap = _mm256_set1_epi16(kernel.taps[j * width + i]);
+                    const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[j] + x + i));
+
+                    lo_sum = _mm256_add_epi16(lo_sum, _mm256_mullo_epi16(_mm256_unpacklo_epi8(value, zero), tap));
+                    hi_sum = _mm256_add_epi16(hi_sum, _mm256_mullo_epi16(_mm256_unpackhi_epi8(value, zero), tap));
+                }
+            }
+
+            /* unpack and pack both work within 128-bit lanes, so the pixel order is restored */
+            const auto packed = _mm256_packus_epi16(_mm256_sra_epi16(lo_sum, shift), _mm256_sra_epi16(hi_sum, shift));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), packed);
+        }
+
+        return x;
+    }
+#endif
+
+    void operator ()(byte* out, int width, simd_level level) const
+    {
+        int x = 0;
+
+        if (kernel.fits_int16())
+        {
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+            if (level == simd_level::avx2)
+            {
+                x = avx2(out, x, width);
+            }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+            if (level != simd_level::none)
+            {
+                x = sse2(out, x, width);
+            }
+#endif
+        }
+
+        scalar(out, x, width);
+    }
+};
+
+inline void convolve_fixed_point(byte_image::const_view_type source, byte_image::view_type dest, const fixed_point_kernel_t& kernel, simd_level level = get_simd_level())
+{
+    const auto valid_size = source.size() - kernel.size + size_type{ 1, 1 };
+
+    if (valid_size.x() <= 0 || valid_size.y() <= 0)
+    {
+        return;
+    }
+
+    source_rows rows{ source, kernel.size.y() };
+    dest_row out{ dest, valid_size.x() };
+
+    std::vector<const byte*> row_ptrs(kernel.size.y());
+
+    for (int y = 0; y < valid_size.y(); ++y)
+    {
+        for (int j = 0; j < kernel.size.y(); ++j)
+        {
+            row_ptrs[j] = rows[y + j];
+        }
+
+        const auto row_fn = fixed_point_row_fn{ row_ptrs.data(), kernel };
+
+        row_fn(out.get(y), valid_size.x(), level);
+
+        out.commit(y);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_FIXED_POINT_CONVOLUTION_HPP_ */
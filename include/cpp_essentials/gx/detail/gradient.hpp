@@ -0,0 +1,350 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_GRADIENT_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_GRADIENT_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/fixed_point_convolution.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class gradient_norm
+{
+    l2,
+    l1,
+    squared,
+};
+
+namespace detail
+{
+
+/* Both responses of an integer gradient pair are accumulated in one pass over the neighborhood. */
+struct gradient_row_fn
+{
+    const byte* const* rows;
+    const fixed_point_kernel_t& kernel_x;
+    const fixed_point_kernel_t& kernel_y;
+
+    void scalar(std::int32_t* out_x, std::int32_t* out_y, int begin, int end) const
+    {
+        const auto width = kernel_x.size.x();
+        const auto height = kernel_x.size.y();
+
+        for (int x = begin; x < end; ++x)
+        {
+            std::int32_t sum_x = 0;
+            std::int32_t sum_y = 0;
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    const std::int32_t value = rows[j][x + i];
+
+                    sum_x += value * kernel_x.taps[j * width + i];
+                    sum_y += value * kernel_y.taps[j * width + i];
+                }
+            }
+
+            out_x[x] = sum_x;
+            out_y[x] = sum_y;
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+    static void store(std::int32_t* out, __m128i value)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16));
+    }
+
+    int sse2(std::int32_t* out_x, std::int32_t* out_y, int x, int end) const
+    {
+        const auto width = kernel_x.size.x();
+        const auto height = kernel_x.size.y();
+        const auto zero = _mm_setzero_si128();
+
+        for (; x + 16 <= end; x += 16)
+        {
+            __m128i sum[4] = { zero, zero, zero, zero };
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    const auto tap_x = _mm_set1_epi16(kernel_x.taps[j * width + i]);
+                    const auto tap_y = _mm_set1_epi16(kernel_y.taps[j * width + i]);
+                    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[j] + x + i));
+                    const auto lo = _mm_unpacklo_epi8(value, zero);
+                    const auto hi = _mm_unpackhi_epi8(value, zero);
+
+                    sum[0] = _mm_add_epi16(sum[0], _mm_mullo_epi16(lo, tap_x));
+                    sum[1] = _mm_add_epi16(sum[1], _mm_mullo_epi16(hi, tap_x));
+                    sum[2] = _mm_add_epi16(sum[2], _mm_mullo_epi16(lo, tap_y));
+                    sum[3] = _mm_add_epi16(sum[3], _mm_mullo_epi16(hi, tap_y));
+                }
+            }
+
+            store(out_x + x, sum[0]);
+            store(out_x + x + 8, sum[1]);
+            store(out_y + x, sum[2]);
+            store(out_y + x + 8, sum[3]);
+        }
+
+        return x;
+    }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    static void store(std::int32_t* out, __m256i value)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepi16_epi32(_mm256_castsi256_si128(value)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_cvtepi16_epi32(_mm256_extracti128_si256(value, 1)));
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    int avx2(std::int32_t* out_x, std::int32_t* out_y, int x, int end) const
+    {
+        const auto width = kernel_x.size.x();
+        const auto height = kernel_x.size.y();
+        const auto zero = _mm256_setzero_si256();
+
+        for (; x + 16 <= end; x += 16)
+        {
+            auto sum_x = zero;
+            auto sum_y = zero;
+
+            for (int j = 0; j < height; ++j)
+            {
+                for (int i = 0; i < width; ++i)
+                {
+                    const auto tap_x = _mm256_set1_epi16(kernel_x.taps[j * width + i]);
+                    const auto tap_y = _mm256_set1_epi16(kernel_y.taps[j * width + i]);
+                    const auto value = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[j] + x + i)));
+
+                    sum_x = _mm256_add_epi16(sum_x, _mm256_mullo_epi16(value, tap_x));
+                    sum_y = _mm256_add_epi16(sum_y, _mm256_mullo_epi16(value, tap_y));
+                }
+            }
+
+            store(out_x + x, sum_x);
+            store(out_y + x, sum_y);
+        }
+
+        return x;
+    }
+#endif
+
+    void operator ()(std::int32_t* out_x, std::int32_t* out_y, int width, simd_level level) const
+    {
+        int x = 0;
+
+        if (kernel_x.fits_int16() && kernel_y.fits_int16())
+        {
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+            if (level == simd_level::avx2)
+            {
+                x = avx2(out_x, out_y, x, width);
+            }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+            if (level != simd_level::none)
+            {
+                x = sse2(out_x, out_y, x, width);
+            }
+#endif
+        }
+
+        scalar(out_x, out_y, x, width);
+    }
+};
+
+/* Only integer kernel pairs of equal size are fused; scaled taps would make the responses fractional. */
+inline bool can_fuse_gradient(const core::optional<fixed_point_kernel_t>& kernel_x, const core::optional<fixed_point_kernel_t>& kernel_y)
+{
+    return kernel_x && kernel_y
+        && kernel_x->shift == 0 && kernel_y->shift == 0
+        && kernel_x->size == kernel_y->size;
+}
+
+template <gradient_norm Norm>
+struct gradient_norm_fn;
+
+template <>
+struct gradient_norm_fn<gradient_norm::l2>
+{
+    std::int64_t operator ()(std::int32_t dx, std::int32_t dy) const
+    {
+        return std::int64_t(std::sqrt(float(std::int64_t(dx) * dx + std::int64_t(dy) * dy)));
+    }
+};
+
+template <>
+struct gradient_norm_fn<gradient_norm::l1>
+{
+    std::int64_t operator ()(std::int32_t dx, std::int32_t dy) const
+    {
+        return std::int64_t(std::abs(dx)) + std::abs(dy);
+    }
+};
+
+template <>
+struct gradient_norm_fn<gradient_norm::squared>
+{
+    std::int64_t operator ()(std::int32_t dx, std::int32_t dy) const
+    {
+        return std::int64_t(dx) * dx + std::int64_t(dy) * dy;
+    }
+};
+
+/* 0: horizontal gradient (vertical edge), 1: 45 degrees, 2: vertical gradient, 3: 135 degrees; y grows downwards. */
+inline byte get_gradient_direction(std::int32_t dx, std::int32_t dy)
+{
+    /* tan(22.5) ~ 0.4142 = 53 / 128 */
+    const auto ax = std::abs(std::int64_t(dx));
+    const auto ay = std::abs(std::int64_t(dy));
+
+    const auto diagonal = (dx > 0) == (dy > 0) ? 1 : 3;
+
+    return byte(ay * 128 <= ax * 53 ? 0 : ax * 128 <= ay * 53 ? 2 : diagonal);
+}
+
+template <class T>
+T saturate_magnitude(std::int64_t value)
+{
+    return T(std::min<std::int64_t>(value, std::numeric_limits<T>::max()));
+}
+
+template <class T, class Norm>
+void store_magnitude(typename image<T>::view_type magnitude, int y, int width, const std::int32_t* response_x, const std::int32_t* response_y, Norm norm)
+{
+    auto* ptr = reinterpret_cast<byte*>(magnitude.data({ 0, y }));
+    const auto step = magnitude.stride()[0];
+
+    for (int x = 0; x < width; ++x, ptr += step)
+    {
+        *reinterpret_cast<T*>(ptr) = saturate_magnitude<T>(norm(response_x[x], response_y[x]));
+    }
+}
+
+/* Calls row_fn(y, response_x, response_y) for every valid row and turns the responses into magnitude and, optionally, direction. */
+template <class T, class RowFn>
+void gradient_rows(
+    const size_type& valid_size,
+    typename image<T>::view_type magnitude,
+    byte_image::view_type* direction,
+    gradient_norm norm,
+    RowFn row_fn)
+{
+    std::vector<std::int32_t> response_x(valid_size.x());
+    std::vector<std::int32_t> response_y(valid_size.x());
+
+    for (int y = 0; y < valid_size.y(); ++y)
+    {
+        row_fn(y, response_x.data(), response_y.data());
+
+        switch (norm)
+        {
+            case gradient_norm::l1:
+                store_magnitude<T>(magnitude, y, valid_size.x(), response_x.data(), response_y.data(), gradient_norm_fn<gradient_norm::l1>{});
+                break;
+            case gradient_norm::squared:
+                store_magnitude<T>(magnitude, y, valid_size.x(), response_x.data(), response_y.data(), gradient_norm_fn<gradient_norm::squared>{});
+                break;
+            default:
+                store_magnitude<T>(magnitude, y, valid_size.x(), response_x.data(), response_y.data(), gradient_norm_fn<gradient_norm::l2>{});
+                break;
+        }
+
+        if (direction)
+        {
+            auto* ptr = direction->data({ 0, y });
+            const auto step = direction->stride()[0];
+
+            for (int x = 0; x < valid_size.x(); ++x, ptr += step)
+            {
+                *ptr = get_gradient_direction(response_x[x], response_y[x]);
+            }
+        }
+    }
+}
+
+template <class T>
+void fused_gradient(
+    byte_image::const_view_type source,
+    typename image<T>::view_type magnitude,
+    byte_image::view_type* direction,
+    const fixed_point_kernel_t& kernel_x,
+    const fixed_point_kernel_t& kernel_y,
+    gradient_norm norm,
+    simd_level level = get_simd_level())
+{
+    const auto valid_size = source.size() - kernel_x.size + size_type{ 1, 1 };
+
+    if (valid_size.x() <= 0 || valid_size.y() <= 0)
+    {
+        return;
+    }
+
+    source_rows rows{ source, kernel_x.size.y() };
+
+    std::vector<const byte*> row_ptrs(kernel_x.size.y());
+
+    gradient_rows<T>(valid_size, magnitude, direction, norm, [&](int y, std::int32_t* response_x, std::int32_t* response_y)
+    {
+        for (int j = 0; j < kernel_x.size.y(); ++j)
+        {
+            row_ptrs[j] = rows[y + j];
+        }
+
+        gradient_row_fn{ row_ptrs.data(), kernel_x, kernel_y }(response_x, response_y, valid_size.x(), level);
+    });
+}
+
+/* Fallback for kernels with fractional taps: responses are rounded to integers. */
+template <class T>
+void region_gradient(
+    byte_image::const_view_type source,
+    typename image<T>::view_type magnitude,
+    byte_image::view_type* direction,
+    const kernel_type& kernel_x,
+    const kernel_type& kernel_y,
+    gradient_norm norm)
+{
+    const auto kernel_size = kernel_x.size();
+    const auto valid_size = source.size() - kernel_size + size_type{ 1, 1 };
+
+    if (valid_size.x() <= 0 || valid_size.y() <= 0)
+    {
+        return;
+    }
+
+    gradient_rows<T>(valid_size, magnitude, direction, norm, [&](int y, std::int32_t* response_x, std::int32_t* response_y)
+    {
+        for (int x = 0; x < valid_size.x(); ++x)
+        {
+            const auto region = source.region({ location_type{ x, y }, location_type{ x, y } + kernel_size });
+
+            response_x[x] = std::int32_t(std::lround(core::inner_product(region, kernel_x, 0.F)));
+            response_y[x] = std::int32_t(std::lround(core::inner_product(region, kernel_y, 0.F)));
+        }
+    });
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_GRADIENT_HPP_ */
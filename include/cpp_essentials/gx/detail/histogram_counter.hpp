@@ -0,0 +1,150 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_HISTOGRAM_COUNTER_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_HISTOGRAM_COUNTER_HPP_
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+using histogram_t = std::array<size_t, 256>;
+
+/* Counts bytes into several interleaved 32-bit sub-histograms so that runs of equal values do not serialize on a single counter;
+   the sub-histograms are folded into size_t results before they can overflow. */
+template <size_t Channels>
+class histogram_counter
+{
+public:
+    static constexpr size_t lanes = Channels == 1 ? 4 : 2;
+
+    using result_type = std::array<histogram_t, Channels>;
+
+    histogram_counter()
+    {
+        for (auto& histogram : _result)
+        {
+            histogram.fill(0);
+        }
+
+        clear_counts();
+    }
+
+    /* step is the distance in bytes between consecutive pixels of the row */
+    void add_row(const byte* ptr, int width, std::ptrdiff_t step)
+    {
+        if (_pending + size_t(width) > max_pending)
+        {
+            flush();
+        }
+
+        _pending += size_t(width);
+
+        if constexpr (Channels == 1)
+        {
+            int x = 0;
+
+            if (step == 1)
+            {
+                for (; x + 4 <= width; x += 4, ptr += 4)
+                {
+                    ++_counts[0][ptr[0]];
+                    ++_counts[1][ptr[1]];
+                    ++_counts[2][ptr[2]];
+                    ++_counts[3][ptr[3]];
+                }
+            }
+
+            for (; x < width; ++x, ptr += step)
+            {
+                ++_counts[0][*ptr];
+            }
+        }
+        else
+        {
+            int x = 0;
+
+            for (; x + 2 <= width; x += 2, ptr += 2 * step)
+            {
+                for (size_t c = 0; c < Channels; ++c)
+                {
+                    ++_counts[c * lanes + 0][ptr[c]];
+                    ++_counts[c * lanes + 1][ptr[step + c]];
+                }
+            }
+
+            for (; x < width; ++x, ptr += step)
+            {
+                for (size_t c = 0; c < Channels; ++c)
+                {
+                    ++_counts[c * lanes][ptr[c]];
+                }
+            }
+        }
+    }
+
+    template <class View>
+    void add(const View& view)
+    {
+        const auto step = view.stride()[0];
+
+        for (int y = 0; y < view.height(); ++y)
+        {
+            add_row(reinterpret_cast<const byte*>(view.data({ 0, y })), view.width(), step);
+        }
+    }
+
+    const result_type& result()
+    {
+        flush();
+        return _result;
+    }
+
+private:
+    static constexpr size_t max_pending = size_t(1) << 31;
+
+    void flush()
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                const auto& counts = _counts[c * lanes + lane];
+
+                for (size_t i = 0; i < counts.size(); ++i)
+                {
+                    _result[c][i] += counts[i];
+                }
+            }
+        }
+
+        clear_counts();
+    }
+
+    void clear_counts()
+    {
+        for (auto& counts : _counts)
+        {
+            counts.fill(0);
+        }
+
+        _pending = 0;
+    }
+
+    std::array<std::array<std::uint32_t, 256>, lanes * Channels> _counts;
+    result_type _result;
+    size_t _pending;
+};
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_HISTOGRAM_COUNTER_HPP_ */
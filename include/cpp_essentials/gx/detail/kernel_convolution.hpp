@@ -0,0 +1,199 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_KERNEL_CONVOLUTION_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_KERNEL_CONVOLUTION_HPP_
+
+#pragma once
+
+#include <array>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+static constexpr int max_small_kernel_size = 5;
+
+inline bool is_small_kernel(const size_type& size)
+{
+    return size.x() == size.y() && (size.x() == 3 || size.x() == max_small_kernel_size);
+}
+
+/* Row kernels accumulate taps in the same order as core::inner_product over a region, so all paths are bit-exact. */
+struct small_kernel_row_fn
+{
+    const byte* const* rows;
+    const float* taps;
+    int size;
+
+    void scalar(byte* out, int begin, int end) const
+    {
+        for (int x = begin; x < end; ++x)
+        {
+            auto sum = 0.F;
+
+            for (int j = 0; j < size; ++j)
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    sum += rows[j][x + i] * taps[j * size + i];
+                }
+            }
+
+            out[x] = to_byte(sum);
+        }
+    }
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+    int sse2(byte* out, int x, int width) const
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto lower = _mm_setzero_ps();
+        const auto upper = _mm_set1_ps(255.F);
+
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128 sum[4] = { lower, lower, lower, lower };
+
+            for (int j = 0; j < size; ++j)
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    const auto tap = _mm_set1_ps(taps[j * size + i]);
+                    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[j] + x + i));
+                    const auto lo = _mm_unpacklo_epi8(value, zero);
+                    const auto hi = _mm_unpackhi_epi8(value, zero);
+
+                    sum[0] = _mm_add_ps(sum[0], _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), tap));
+                    sum[1] = _mm_add_ps(sum[1], _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), tap));
+                    sum[2] = _mm_add_ps(sum[2], _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), tap));
+                    sum[3] = _mm_add_ps(sum[3], _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), tap));
+                }
+            }
+
+            __m128i result[4];
+
+            for (int k = 0; k < 4; ++k)
+            {
+                result[k] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(sum[k], lower), upper));
+            }
+
+            const auto packed = _mm_packus_epi16(
+                _mm_packs_epi32(result[0], result[1]),
+                _mm_packs_epi32(result[2], result[3]));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), packed);
+        }
+
+        return x;
+    }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    int avx2(byte* out, int x, int width) const
+    {
+        const auto lower = _mm256_setzero_ps();
+        const auto upper = _mm256_set1_ps(255.F);
+        const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        for (; x + 32 <= width; x += 32)
+        {
+            __m256 sum[4] = { lower, lower, lower, lower };
+
+            for (int j = 0; j < size; ++j)
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    const auto tap = _mm256_set1_ps(taps[j * size + i]);
+                    const auto* ptr = rows[j] + x + i;
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        const auto value = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr + 8 * k)));
+                        sum[k] = _mm256_add_ps(sum[k], _mm256_mul_ps(_mm256_cvtepi32_ps(value), tap));
+                    }
+                }
+            }
+
+            __m256i result[4];
+
+            for (int k = 0; k < 4; ++k)
+            {
+                result[k] = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(sum[k], lower), upper));
+            }
+
+            const auto packed = _mm256_packus_epi16(
+                _mm256_packs_epi32(result[0], result[1]),
+                _mm256_packs_epi32(result[2], result[3]));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), _mm256_permutevar8x32_epi32(packed, order));
+        }
+
+        return x;
+    }
+#endif
+
+    void operator ()(byte* out, int width, simd_level level) const
+    {
+        int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+        if (level == simd_level::avx2)
+        {
+            x = avx2(out, x, width);
+        }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+        if (level != simd_level::none)
+        {
+            x = sse2(out, x, width);
+        }
+#endif
+
+        scalar(out, x, width);
+    }
+};
+
+inline void convolve_small_kernel(byte_image::const_view_type source, byte_image::view_type dest, const kernel_type& kernel, simd_level level = get_simd_level())
+{
+    const auto size = kernel.width();
+    const auto valid_size = source.size() - kernel.size() + size_type{ 1, 1 };
+
+    if (valid_size.x() <= 0 || valid_size.y() <= 0)
+    {
+        return;
+    }
+
+    std::array<float, max_small_kernel_size * max_small_kernel_size> taps;
+    core::copy(kernel, taps.begin());
+
+    source_rows rows{ source, size };
+    dest_row out{ dest, valid_size.x() };
+
+    std::array<const byte*, max_small_kernel_size> row_ptrs;
+
+    for (int y = 0; y < valid_size.y(); ++y)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            row_ptrs[j] = rows[y + j];
+        }
+
+        const auto row_fn = small_kernel_row_fn{ row_ptrs.data(), taps.data(), size };
+
+        row_fn(out.get(y), valid_size.x(), level);
+
+        out.commit(y);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_KERNEL_CONVOLUTION_HPP_ */
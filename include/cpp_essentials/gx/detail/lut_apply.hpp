@@ -0,0 +1,183 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_LUT_APPLY_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_LUT_APPLY_HPP_
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+inline void lut_row_scalar(const byte* table, const byte* src, byte* dst, int begin, int end)
+{
+    int x = begin;
+
+    for (; x + 4 <= end; x += 4)
+    {
+        const auto v0 = table[src[x + 0]];
+        const auto v1 = table[src[x + 1]];
+        const auto v2 = table[src[x + 2]];
+        const auto v3 = table[src[x + 3]];
+
+        dst[x + 0] = v0;
+        dst[x + 1] = v1;
+        dst[x + 2] = v2;
+        dst[x + 3] = v3;
+    }
+
+    for (; x < end; ++x)
+    {
+        dst[x] = table[src[x]];
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* The table is split into 16 slices of 16 bytes, each looked up with pshufb. Subtracting 16 per slice and adding 0x70 with
+   unsigned saturation leaves the high bit clear only in lanes whose value falls into the current slice, so the others read 0. */
+struct lut_avx2
+{
+    __m256i slices[16];
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    explicit lut_avx2(const byte* table)
+    {
+        for (int k = 0; k < 16; ++k)
+        {
+            slices[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * k)));
+        }
+    }
+
+    CPP_ESSENTIALS_GX_TARGET("avx2")
+    __m256i lookup(__m256i index) const
+    {
+        const auto offset = _mm256_set1_epi8(0x70);
+        const auto step = _mm256_set1_epi8(16);
+
+        auto result = _mm256_shuffle_epi8(slices[0], _mm256_adds_epu8(index, offset));
+
+        for (int k = 1; k < 16; ++k)
+        {
+            index = _mm256_sub_epi8(index, step);
+            result = _mm256_or_si256(result, _mm256_shuffle_epi8(slices[k], _mm256_adds_epu8(index, offset)));
+        }
+
+        return result;
+    }
+};
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int lut_row_avx2(const byte* table, const byte* src, byte* dst, int count)
+{
+    const lut_avx2 lut{ table };
+
+    int x = 0;
+
+    for (; x + 32 <= count; x += 32)
+    {
+        const auto index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), lut.lookup(index));
+    }
+
+    return x;
+}
+
+/* Every fourth byte (alpha) is copied from the source. */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int rgba_lut_row_avx2(const byte* table, const byte* src, byte* dst, int count)
+{
+    const lut_avx2 lut{ table };
+    const auto alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int x = 0;
+
+    for (; x + 32 <= count; x += 32)
+    {
+        const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), _mm256_blendv_epi8(lut.lookup(value), value, alpha));
+    }
+
+    return x;
+}
+#endif
+
+/* count is the number of bytes of a contiguous row */
+inline void lut_row(const byte* table, const byte* src, byte* dst, int count, simd_level level = get_simd_level())
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        x = lut_row_avx2(table, src, dst, count);
+    }
+#endif
+
+    lut_row_scalar(table, src, dst, x, count);
+}
+
+inline void rgba_lut_row(const byte* table, const byte* src, byte* dst, int count, simd_level level = get_simd_level())
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        x = rgba_lut_row_avx2(table, src, dst, count);
+    }
+#endif
+
+    for (; x < count; x += 4)
+    {
+        dst[x + 0] = table[src[x + 0]];
+        dst[x + 1] = table[src[x + 1]];
+        dst[x + 2] = table[src[x + 2]];
+        dst[x + 3] = src[x + 3];
+    }
+}
+
+/* Byte to rgb colormap; the palette is widened to 4 bytes per entry so that each pixel is a single overlapping 4-byte store. */
+class palette_rows
+{
+public:
+    explicit palette_rows(const std::array<rgb_color, 256>& palette)
+    {
+        for (size_t i = 0; i < palette.size(); ++i)
+        {
+            const byte entry[4] = { palette[i][0], palette[i][1], palette[i][2], 0 };
+            std::memcpy(&_entries[i], entry, sizeof(entry));
+        }
+    }
+
+    void operator ()(const byte* src, byte* dst, int width) const
+    {
+        int x = 0;
+
+        for (; x + 1 < width; ++x, dst += 3)
+        {
+            std::memcpy(dst, &_entries[src[x]], 4);
+        }
+
+        for (; x < width; ++x, dst += 3)
+        {
+            std::memcpy(dst, &_entries[src[x]], 3);
+        }
+    }
+
+private:
+    std::array<std::uint32_t, 256> _entries;
+};
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_LUT_APPLY_HPP_ */
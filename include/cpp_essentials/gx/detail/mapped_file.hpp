@@ -0,0 +1,165 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_MAPPED_FILE_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_MAPPED_FILE_HPP_
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* Read-only mapping of a whole file; the pages stay mapped until the object is destroyed. */
+class mapped_file
+{
+public:
+    mapped_file() = default;
+
+    explicit mapped_file(const std::string& path)
+    {
+#if defined(_WIN32)
+        const auto file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error{ "mapped_file: cannot open " + path };
+        }
+
+        LARGE_INTEGER size;
+
+        if (!::GetFileSizeEx(file, &size))
+        {
+            ::CloseHandle(file);
+            throw std::runtime_error{ "mapped_file: cannot get size of " + path };
+        }
+
+        _size = size_t(size.QuadPart);
+
+        if (_size > 0)
+        {
+            const auto mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (mapping)
+            {
+                _data = static_cast<const unsigned char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                ::CloseHandle(mapping);
+            }
+        }
+
+        ::CloseHandle(file);
+#else
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            throw std::runtime_error{ "mapped_file: cannot open " + path };
+        }
+
+        struct stat info;
+
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error{ "mapped_file: cannot get size of " + path };
+        }
+
+        _size = size_t(info.st_size);
+
+        if (_size > 0)
+        {
+            const auto ptr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            _data = ptr != MAP_FAILED ? static_cast<const unsigned char*>(ptr) : nullptr;
+        }
+
+        ::close(fd);
+#endif
+
+        if (_size > 0 && !_data)
+        {
+            throw std::runtime_error{ "mapped_file: cannot map " + path };
+        }
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator =(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : _data(std::exchange(other._data, nullptr))
+        , _size(std::exchange(other._size, 0))
+    {
+    }
+
+    mapped_file& operator =(mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        unmap();
+    }
+
+    const unsigned char* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    void unmap()
+    {
+        if (!_data)
+        {
+            return;
+        }
+
+#if defined(_WIN32)
+        ::UnmapViewOfFile(_data);
+#else
+        ::munmap(const_cast<unsigned char*>(_data), _size);
+#endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+
+    const unsigned char* _data = nullptr;
+    size_t _size = 0;
+};
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_MAPPED_FILE_HPP_ */
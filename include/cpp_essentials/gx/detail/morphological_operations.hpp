@@ -4,9 +4,16 @@
 #pragma once
 
 #include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/integral_image.hpp>
 #include <cpp_essentials/sq/sq.hpp>
 #include <cpp_essentials/core/container_helpers.hpp>
 #include <cpp_essentials/core/views/elementwise.hpp>
+#include <cpp_essentials/core/optional.hpp>
+#include <cpp_essentials/gx/detail/fixed_point_convolution.hpp>
+#include <cpp_essentials/gx/detail/gradient.hpp>
+#include <cpp_essentials/gx/detail/kernel_convolution.hpp>
+#include <cpp_essentials/gx/detail/running_extremum.hpp>
+#include <cpp_essentials/gx/detail/sliding_histogram.hpp>
 
 namespace cpp_essentials::gx
 {
@@ -16,7 +23,7 @@ using byte_mask = byte_image;
 namespace detail
 {
 
-size_type get_valid_size(size_type image_size, size_type kernel_size)
+inline size_type get_valid_size(size_type image_size, size_type kernel_size)
 {
     return image_size - kernel_size + size_type{ 1, 1 };
 }
@@ -25,9 +32,190 @@ template <class Tag, size_t D>
 struct convolution_t
 {
     byte operator ()(byte_image::const_view_type region) const;
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const;
     size_type size() const;
 };
 
+template <class Convolution>
+void convolve_regions(byte_image::const_view_type source, byte_image::view_type dest, const Convolution& convolution)
+{
+    auto kernel_size = convolution.size();
+
+    auto size = get_valid_size(source.size(), kernel_size);
+
+    core::transform(
+        source.region_range(kernel_size),
+        dest.region({ geo::zeros, size }).begin(),
+        convolution);
+}
+
+
+
+struct separable_kernel_t
+{
+    std::vector<float> row;
+    std::vector<float> column;
+
+    size_type size() const
+    {
+        return { static_cast<int>(row.size()), static_cast<int>(column.size()) };
+    }
+
+    kernel_type to_kernel() const
+    {
+        kernel_type result(size());
+
+        for (auto it : core::views::iterate(result))
+        {
+            *it = row[it.location().x()] * column[it.location().y()];
+        }
+
+        return result;
+    }
+};
+
+inline core::optional<separable_kernel_t> make_separable(const kernel_type& kernel, float epsilon = 1e-6F)
+{
+    if (kernel.empty())
+    {
+        return core::none;
+    }
+
+    auto pivot = location_type{};
+    auto pivot_value = 0.F;
+
+    for (auto it : core::views::iterate(kernel))
+    {
+        if (std::abs(*it) > std::abs(pivot_value))
+        {
+            pivot = it.location();
+            pivot_value = *it;
+        }
+    }
+
+    if (pivot_value == 0.F)
+    {
+        return core::none;
+    }
+
+    separable_kernel_t result;
+
+    for (int x = 0; x < kernel.width(); ++x)
+    {
+        result.row.push_back(kernel[{ x, pivot.y() }]);
+    }
+
+    for (int y = 0; y < kernel.height(); ++y)
+    {
+        result.column.push_back(kernel[{ pivot.x(), y }] / pivot_value);
+    }
+
+    const auto tolerance = epsilon * std::abs(pivot_value);
+
+    for (auto it : core::views::iterate(kernel))
+    {
+        const auto loc = it.location();
+
+        if (std::abs(result.row[loc.x()] * result.column[loc.y()] - *it) > tolerance)
+        {
+            return core::none;
+        }
+    }
+
+    return result;
+}
+
+/* True when all the weights are equal and non-zero, i.e. the kernel is a scaled box. */
+inline bool is_uniform(const kernel_type& kernel)
+{
+    return !kernel.empty()
+        && *kernel.begin() != 0.F
+        && core::all_of(kernel, [&](float v) { return v == *kernel.begin(); });
+}
+
+/* Every output is weight times the sum under the kernel, read from an integral image in constant time regardless of the kernel size. */
+inline void convolve_box(byte_image::const_view_type source, byte_image::view_type dest, const size_type& kernel_size, float weight)
+{
+    const auto size = get_valid_size(source.size(), kernel_size);
+
+    if (size.x() <= 0 || size.y() <= 0)
+    {
+        return;
+    }
+
+    const integral_image integral{ source };
+
+    dest_row out{ dest, size.x() };
+
+    for (int y = 0; y < size.y(); ++y)
+    {
+        const auto* top = integral.row(y);
+        const auto* bottom = integral.row(y + kernel_size.y());
+        auto* ptr = out.get(y);
+
+        for (int x = 0; x < size.x(); ++x)
+        {
+            const auto sum = bottom[x + kernel_size.x()] - bottom[x] - top[x + kernel_size.x()] + top[x];
+
+            ptr[x] = to_byte(float(sum) * weight);
+        }
+
+        out.commit(y);
+    }
+}
+
+/* Vertical pass accumulates kernel.column into a single row buffer, horizontal pass then applies kernel.row to it. */
+inline void convolve_separable(byte_image::const_view_type source, byte_image::view_type dest, const separable_kernel_t& kernel)
+{
+    const auto size = get_valid_size(source.size(), kernel.size());
+
+    if (size.x() <= 0 || size.y() <= 0)
+    {
+        return;
+    }
+
+    const auto source_step = source.stride()[0];
+    const auto dest_step = dest.stride()[0];
+
+    std::vector<float> buffer(source.width());
+
+    for (int y = 0; y < size.y(); ++y)
+    {
+        core::fill(buffer, 0.F);
+
+        for (int j = 0; j < int(kernel.column.size()); ++j)
+        {
+            const auto weight = kernel.column[j];
+
+            if (weight == 0.F)
+            {
+                continue;
+            }
+
+            const auto* ptr = source.data({ 0, y + j });
+
+            for (int x = 0; x < source.width(); ++x, ptr += source_step)
+            {
+                buffer[x] += weight * *ptr;
+            }
+        }
+
+        auto* ptr = dest.data({ 0, y });
+
+        for (int x = 0; x < size.x(); ++x, ptr += dest_step)
+        {
+            auto sum = 0.F;
+
+            for (int i = 0; i < int(kernel.row.size()); ++i)
+            {
+                sum += kernel.row[i] * buffer[x + i];
+            }
+
+            *ptr = to_byte(sum);
+        }
+    }
+}
+
 struct dilation_tag {};
 struct erosion_tag {};
 struct percentile_tag {};
@@ -43,8 +231,12 @@ struct convolution_t<dilation_tag, 1>
 
     byte operator ()(byte_image::const_view_type region) const
     {
-        auto result = core::max_value(core::views::zip(region, _mask, core::multiplies));
-        return result / 256;
+        return core::max_value(core::views::zip(region, _mask, [](byte value, byte mask) { return mask != 0 ? value : max_op::identity; }));
+    }
+
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        mask_extremum(source, dest, _mask, max_op{});
     }
 
     size_type size() const
@@ -67,12 +259,12 @@ struct convolution_t<erosion_tag, 1>
 
     byte operator ()(byte_image::const_view_type region) const
     {
-        auto result = core::max_value(
-            core::views::zip(
-                core::views::map(region, core::minus.bind_left(255)),
-                _mask,
-                core::multiplies));
-        return 255 - (result / 256);
+        return core::min_value(core::views::zip(region, _mask, [](byte value, byte mask) { return mask != 0 ? value : min_op::identity; }));
+    }
+
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        mask_extremum(source, dest, _mask, min_op{});
     }
 
     size_type size() const
@@ -96,13 +288,33 @@ struct convolution_t<percentile_tag, 1>
 
     byte operator ()(byte_image::const_view_type region) const
     {
-        _vect.clear();
-        core::push_back(_vect, core::views::map(core::views::zip(region, _mask, core::multiplies), core::divides(256)));
+        std::vector<byte> values;
 
-        auto index = _vect.size() * _rank / 100;
-        std::nth_element(_vect.begin(), _vect.begin() + index, _vect.end());
+        for (int y = 0; y < region.height(); ++y)
+        {
+            for (int x = 0; x < region.width(); ++x)
+            {
+                if (_mask[{ x, y }] != 0)
+                {
+                    values.push_back(region[{ x, y }]);
+                }
+            }
+        }
 
-        return _vect[index];
+        if (values.empty())
+        {
+            return 0;
+        }
+
+        auto index = get_percentile_index(values.size(), _rank);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+
+        return values[index];
+    }
+
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        mask_percentile(source, dest, _mask, _rank);
     }
 
     size_type size() const
@@ -112,7 +324,6 @@ struct convolution_t<percentile_tag, 1>
 
     byte_mask _mask;
     int _rank;
-    mutable std::vector<byte> _vect;
 };
 
 
@@ -123,6 +334,7 @@ struct convolution_t<kernel_tag, D>
     convolution_t(const kernel_array_type<D>& kernels)
     {
         core::move(kernels, _kernels.begin());
+        core::transform(_kernels, _fixed_point.begin(), [](const kernel_type& kernel) { return make_fixed_point(kernel); });
     }
 
     byte operator ()(byte_image::const_view_type region) const
@@ -139,12 +351,27 @@ struct convolution_t<kernel_tag, D>
         return to_byte(sum);
     }
 
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        if constexpr (D == 2)
+        {
+            if (can_fuse_gradient(_fixed_point[0], _fixed_point[1]))
+            {
+                fused_gradient<byte>(source, dest, nullptr, *_fixed_point[0], *_fixed_point[1], gradient_norm::l2);
+                return;
+            }
+        }
+
+        convolve_regions(source, dest, *this);
+    }
+
     size_type size() const
     {
         return _kernels[0].size();
     }
 
     kernel_array_type<D> _kernels;
+    std::array<core::optional<fixed_point_kernel_t>, D> _fixed_point;
 };
 
 template <>
@@ -152,6 +379,15 @@ struct convolution_t<kernel_tag, 1>
 {
     convolution_t(const kernel_array_type<1>& kernels)
         : _kernel(std::move(kernels[0]))
+        , _separable(make_separable(_kernel))
+        , _fixed_point(make_fixed_point(_kernel))
+    {
+    }
+
+    convolution_t(separable_kernel_t kernel)
+        : _kernel(kernel.to_kernel())
+        , _separable(std::move(kernel))
+        , _fixed_point(make_fixed_point(_kernel))
     {
     }
 
@@ -162,12 +398,50 @@ struct convolution_t<kernel_tag, 1>
         return to_byte(sum);
     }
 
+    void apply(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        if (is_small_kernel(size()))
+        {
+            _fixed_point
+                ? convolve_fixed_point(source, dest, *_fixed_point)
+                : convolve_small_kernel(source, dest, _kernel);
+        }
+        else if (is_uniform(_kernel))
+        {
+            convolve_box(source, dest, size(), *_kernel.begin());
+        }
+        else if (_separable)
+        {
+            convolve_separable(source, dest, *_separable);
+        }
+        else if (_fixed_point)
+        {
+            convolve_fixed_point(source, dest, *_fixed_point);
+        }
+        else
+        {
+            convolve_regions(source, dest, *this);
+        }
+    }
+
     size_type size() const
     {
         return _kernel.size();
     }
 
+    bool is_separable() const
+    {
+        return _separable.has_value();
+    }
+
+    bool is_fixed_point() const
+    {
+        return _fixed_point.has_value();
+    }
+
     kernel_type _kernel;
+    core::optional<separable_kernel_t> _separable;
+    core::optional<fixed_point_kernel_t> _fixed_point;
 };
 
 } /* namespace detail */
@@ -0,0 +1,309 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_PLANAR_CONVERSION_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_PLANAR_CONVERSION_HPP_
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+template <size_t Channels>
+void deinterleave_row_scalar(const byte* src, std::ptrdiff_t step, const std::array<byte*, Channels>& planes, int begin, int end)
+{
+    src += begin * step;
+
+    for (int x = begin; x < end; ++x, src += step)
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            planes[c][x] = src[c];
+        }
+    }
+}
+
+template <size_t Channels>
+void interleave_row_scalar(const std::array<const byte*, Channels>& planes, byte* dst, std::ptrdiff_t step, int begin, int end)
+{
+    dst += begin * step;
+
+    for (int x = begin; x < end; ++x, dst += step)
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[c] = planes[c][x];
+        }
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* pshufb masks moving bytes between three 16-byte blocks of interleaved rgb and one 16-byte block per plane; 0x80 writes zero. */
+struct rgb_shuffle_masks
+{
+    /* [channel][source block] */
+    byte deinterleave[3][3][16];
+    /* [destination block][channel] */
+    byte interleave[3][3][16];
+
+    rgb_shuffle_masks()
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            for (int block = 0; block < 3; ++block)
+            {
+                for (int i = 0; i < 16; ++i)
+                {
+                    const auto index = 3 * i + c;
+                    deinterleave[c][block][i] = index / 16 == block ? byte(index % 16) : byte(0x80);
+
+                    const auto n = 16 * block + i;
+                    interleave[block][c][i] = n % 3 == c ? byte(n / 3) : byte(0x80);
+                }
+            }
+        }
+    }
+
+    static const rgb_shuffle_masks& instance()
+    {
+        static const rgb_shuffle_masks masks;
+        return masks;
+    }
+};
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m128i load_mask(const byte* mask)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int deinterleave_rgb_row_avx2(const byte* src, const std::array<byte*, 3>& planes, int width)
+{
+    const auto& masks = rgb_shuffle_masks::instance();
+
+    __m128i shuffle[3][3];
+
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int block = 0; block < 3; ++block)
+        {
+            shuffle[c][block] = load_mask(masks.deinterleave[c][block]);
+        }
+    }
+
+    int x = 0;
+
+    for (; x + 16 <= width; x += 16, src += 48)
+    {
+        const __m128i blocks[3] =
+        {
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)),
+        };
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const auto value = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(blocks[0], shuffle[c][0]), _mm_shuffle_epi8(blocks[1], shuffle[c][1])),
+                _mm_shuffle_epi8(blocks[2], shuffle[c][2]));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[c] + x), value);
+        }
+    }
+
+    return x;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int interleave_rgb_row_avx2(const std::array<const byte*, 3>& planes, byte* dst, int width)
+{
+    const auto& masks = rgb_shuffle_masks::instance();
+
+    __m128i shuffle[3][3];
+
+    for (int block = 0; block < 3; ++block)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            shuffle[block][c] = load_mask(masks.interleave[block][c]);
+        }
+    }
+
+    int x = 0;
+
+    for (; x + 16 <= width; x += 16, dst += 48)
+    {
+        const __m128i values[3] =
+        {
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + x)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + x)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2] + x)),
+        };
+
+        for (int block = 0; block < 3; ++block)
+        {
+            const auto value = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(values[0], shuffle[block][0]), _mm_shuffle_epi8(values[1], shuffle[block][1])),
+                _mm_shuffle_epi8(values[2], shuffle[block][2]));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16 * block), value);
+        }
+    }
+
+    return x;
+}
+
+/* Each 16-byte block of rgba is shuffled into rrrr gggg bbbb aaaa, and four blocks are transposed as 4x4 32-bit words. */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int deinterleave_rgba_row_avx2(const byte* src, const std::array<byte*, 4>& planes, int width)
+{
+    const auto gather = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+    int x = 0;
+
+    for (; x + 16 <= width; x += 16, src += 64)
+    {
+        __m128i blocks[4];
+
+        for (int k = 0; k < 4; ++k)
+        {
+            blocks[k] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16 * k)), gather);
+        }
+
+        const auto t0 = _mm_unpacklo_epi32(blocks[0], blocks[1]);
+        const auto t1 = _mm_unpacklo_epi32(blocks[2], blocks[3]);
+        const auto t2 = _mm_unpackhi_epi32(blocks[0], blocks[1]);
+        const auto t3 = _mm_unpackhi_epi32(blocks[2], blocks[3]);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[0] + x), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[1] + x), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[2] + x), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[3] + x), _mm_unpackhi_epi64(t2, t3));
+    }
+
+    return x;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int interleave_rgba_row_avx2(const std::array<const byte*, 4>& planes, byte* dst, int width)
+{
+    int x = 0;
+
+    for (; x + 16 <= width; x += 16, dst += 64)
+    {
+        const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + x));
+        const auto g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + x));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2] + x));
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[3] + x));
+
+        const auto rg_lo = _mm_unpacklo_epi8(r, g);
+        const auto rg_hi = _mm_unpackhi_epi8(r, g);
+        const auto ba_lo = _mm_unpacklo_epi8(b, a);
+        const auto ba_hi = _mm_unpackhi_epi8(b, a);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+    }
+
+    return x;
+}
+
+inline int deinterleave_row_simd(const byte* src, const std::array<byte*, 3>& planes, int width)
+{
+    return deinterleave_rgb_row_avx2(src, planes, width);
+}
+
+inline int deinterleave_row_simd(const byte* src, const std::array<byte*, 4>& planes, int width)
+{
+    return deinterleave_rgba_row_avx2(src, planes, width);
+}
+
+inline int interleave_row_simd(const std::array<const byte*, 3>& planes, byte* dst, int width)
+{
+    return interleave_rgb_row_avx2(planes, dst, width);
+}
+
+inline int interleave_row_simd(const std::array<const byte*, 4>& planes, byte* dst, int width)
+{
+    return interleave_rgba_row_avx2(planes, dst, width);
+}
+#endif
+
+/* pshufb needs SSSE3, which comes with the AVX2 level; the simd path is taken for contiguous rows only. */
+template <size_t Channels>
+void deinterleave_row(const byte* src, std::ptrdiff_t step, const std::array<byte*, Channels>& planes, int width, simd_level level = get_simd_level())
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2 && step == std::ptrdiff_t(Channels))
+    {
+        x = deinterleave_row_simd(src, planes, width);
+    }
+#endif
+
+    deinterleave_row_scalar(src, step, planes, x, width);
+}
+
+template <size_t Channels>
+void interleave_row(const std::array<const byte*, Channels>& planes, byte* dst, std::ptrdiff_t step, int width, simd_level level = get_simd_level())
+{
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2 && step == std::ptrdiff_t(Channels))
+    {
+        x = interleave_row_simd(planes, dst, width);
+    }
+#endif
+
+    interleave_row_scalar(planes, dst, step, x, width);
+}
+
+template <class View, size_t Channels>
+void deinterleave_rows(const View& source, const std::array<byte_image::view_type, Channels>& planes, simd_level level = get_simd_level())
+{
+    for (int y = 0; y < source.height(); ++y)
+    {
+        std::array<byte*, Channels> dst;
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[c] = planes[c].data({ 0, y });
+        }
+
+        deinterleave_row(reinterpret_cast<const byte*>(source.data({ 0, y })), source.stride()[0], dst, source.width(), level);
+    }
+}
+
+template <class View, size_t Channels>
+void interleave_rows(const std::array<byte_image::const_view_type, Channels>& planes, const View& dest, simd_level level = get_simd_level())
+{
+    for (int y = 0; y < dest.height(); ++y)
+    {
+        std::array<const byte*, Channels> src;
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            src[c] = planes[c].data({ 0, y });
+        }
+
+        interleave_row(src, reinterpret_cast<byte*>(dest.data({ 0, y })), dest.stride()[0], dest.width(), level);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_PLANAR_CONVERSION_HPP_ */
@@ -0,0 +1,176 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_POLYGON_RASTERIZER_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_POLYGON_RASTERIZER_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cpp_essentials/geo/vertex_container.hpp>
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class fill_rule
+{
+    even_odd,
+    non_zero
+};
+
+namespace detail
+{
+
+/* Scanline polygon fill with an edge table and an active edge list. A pixel is covered when its center lies inside the
+   polygon; edges are half-open at the bottom and spans at the right, so polygons sharing an edge never overlap. Coverage
+   depends only on the vertices, not on the clip region, so a polygon split between tiles gives the same pixels. */
+class polygon_rasterizer
+{
+public:
+    /* Calls func(y, x_begin, x_end) for every covered half-open span inside clip. */
+    template <class Shape, class Func>
+    void operator ()(const Shape& shape, fill_rule rule, const image_region_t& clip, Func&& func)
+    {
+        build_edges(shape, clip);
+
+        if (_edges.empty())
+        {
+            return;
+        }
+
+        _active.clear();
+
+        auto next = _edges.begin();
+        const auto y_end = std::max_element(_edges.begin(), _edges.end(), [](const edge& lhs, const edge& rhs) { return lhs.y_end < rhs.y_end; })->y_end;
+
+        for (int y = next->y_begin; y < y_end; ++y)
+        {
+            _active.erase(
+                std::remove_if(_active.begin(), _active.end(), [&](const edge& e) { return e.y_end <= y; }),
+                _active.end());
+
+            for (; next != _edges.end() && next->y_begin == y; ++next)
+            {
+                _active.push_back(*next);
+            }
+
+            for (auto& e : _active)
+            {
+                e.x = e.x_origin + y * e.slope;
+            }
+
+            /* the order changes only where edges cross, so insertion sort is close to linear */
+            for (size_t i = 1; i < _active.size(); ++i)
+            {
+                for (size_t j = i; j > 0 && _active[j].x < _active[j - 1].x; --j)
+                {
+                    std::swap(_active[j], _active[j - 1]);
+                }
+            }
+
+            emit_spans(y, rule, clip, func);
+        }
+    }
+
+private:
+    struct edge
+    {
+        int y_begin;
+        int y_end;
+        double x_origin;
+        double slope;
+        double x;
+        int winding;
+    };
+
+    template <class Shape>
+    void build_edges(const Shape& shape, const image_region_t& clip)
+    {
+        _edges.clear();
+
+        const auto count = geo::vertex_count(shape);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto a = geo::get_vertex(shape, i);
+            const auto b = geo::get_vertex(shape, (i + 1) % count);
+
+            const double ax = a.x();
+            const double ay = a.y();
+            const double bx = b.x();
+            const double by = b.y();
+
+            if (ay == by)
+            {
+                continue;
+            }
+
+            const auto down = ay < by;
+            const auto top_x = down ? ax : bx;
+            const auto top_y = down ? ay : by;
+            const auto bottom_y = down ? by : ay;
+
+            edge e;
+            e.y_begin = std::max(int(std::ceil(top_y - 0.5)), clip.lower().y());
+            e.y_end = std::min(int(std::ceil(bottom_y - 0.5)), clip.upper().y());
+
+            if (e.y_begin >= e.y_end)
+            {
+                continue;
+            }
+
+            e.slope = (bx - ax) / (by - ay);
+            e.x_origin = top_x + (0.5 - top_y) * e.slope;
+            e.x = 0.0;
+            e.winding = down ? 1 : -1;
+
+            _edges.push_back(e);
+        }
+
+        std::sort(_edges.begin(), _edges.end(), [](const edge& lhs, const edge& rhs) { return lhs.y_begin < rhs.y_begin; });
+    }
+
+    template <class Func>
+    void emit_spans(int y, fill_rule rule, const image_region_t& clip, Func&& func) const
+    {
+        int winding = 0;
+        double x_begin = 0.0;
+
+        for (const auto& e : _active)
+        {
+            const auto was_inside = is_inside(winding, rule);
+            winding += rule == fill_rule::even_odd ? 1 : e.winding;
+            const auto inside = is_inside(winding, rule);
+
+            if (!was_inside && inside)
+            {
+                x_begin = e.x;
+            }
+            else if (was_inside && !inside)
+            {
+                const auto x0 = std::max(int(std::ceil(x_begin - 0.5)), clip.lower().x());
+                const auto x1 = std::min(int(std::ceil(e.x - 0.5)), clip.upper().x());
+
+                if (x0 < x1)
+                {
+                    func(y, x0, x1);
+                }
+            }
+        }
+    }
+
+    static bool is_inside(int winding, fill_rule rule)
+    {
+        return rule == fill_rule::even_odd ? (winding & 1) != 0 : winding != 0;
+    }
+
+    std::vector<edge> _edges;
+    std::vector<edge> _active;
+};
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_POLYGON_RASTERIZER_HPP_ */
@@ -0,0 +1,250 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_PYRAMID_REDUCTION_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_PYRAMID_REDUCTION_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+inline int get_reduced_size(int size)
+{
+    return (size + 1) / 2;
+}
+
+/* Sums of two source rows; the last pixel of an odd row is paired with itself. */
+template <size_t Channels>
+void box_reduce_row_scalar(const byte* a, const byte* b, byte* dst, int src_width, int begin, int end)
+{
+    for (int x = begin; x < end; ++x)
+    {
+        const auto x0 = 2 * x;
+        const auto x1 = std::min(x0 + 1, src_width - 1);
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            const auto i0 = x0 * Channels + c;
+            const auto i1 = x1 * Channels + c;
+
+            dst[x * Channels + c] = byte((a[i0] + a[i1] + b[i0] + b[i1] + 2) >> 2);
+        }
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* 32 source bytes of each row give 16 outputs; maddubs adds horizontal byte pairs into 16-bit lanes. */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int box_reduce_row_avx2(const byte* a, const byte* b, byte* dst, int src_width, std::integral_constant<size_t, 1>)
+{
+    const auto ones = _mm256_set1_epi8(1);
+    const auto round = _mm256_set1_epi16(2);
+
+    int x = 0;
+
+    for (; 2 * x + 32 <= src_width; x += 16)
+    {
+        const auto ra = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 2 * x));
+        const auto rb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 2 * x));
+
+        const auto sum = _mm256_add_epi16(_mm256_add_epi16(_mm256_maddubs_epi16(ra, ones), _mm256_maddubs_epi16(rb, ones)), round);
+        const auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(sum, 2), _mm256_setzero_si256()), 0x08);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm256_castsi256_si128(packed));
+    }
+
+    return x;
+}
+
+/* Eight rgba pixels of each row give four outputs; pixels are widened to 16-bit and neighbours added by swapping 64-bit halves. */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int box_reduce_row_avx2(const byte* a, const byte* b, byte* dst, int src_width, std::integral_constant<size_t, 4>)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto round = _mm256_set1_epi16(2);
+
+    int x = 0;
+
+    for (; 2 * x + 8 <= src_width; x += 4)
+    {
+        const auto ra = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 8 * x));
+        const auto rb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 8 * x));
+
+        /* lo: pixels 0, 1 | 4, 5; hi: pixels 2, 3 | 6, 7 */
+        const auto lo = _mm256_add_epi16(_mm256_unpacklo_epi8(ra, zero), _mm256_unpacklo_epi8(rb, zero));
+        const auto hi = _mm256_add_epi16(_mm256_unpackhi_epi8(ra, zero), _mm256_unpackhi_epi8(rb, zero));
+
+        const auto lo_pairs = _mm256_add_epi16(lo, _mm256_shuffle_epi32(lo, 0x4E));
+        const auto hi_pairs = _mm256_add_epi16(hi, _mm256_shuffle_epi32(hi, 0x4E));
+
+        const auto sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo_pairs, hi_pairs), round), 2);
+        const auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, zero), 0x08);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * x), _mm256_castsi256_si128(packed));
+    }
+
+    return x;
+}
+
+template <size_t Channels>
+int box_reduce_row_avx2(const byte*, const byte*, byte*, int, std::integral_constant<size_t, Channels>)
+{
+    return 0;
+}
+#endif
+
+template <size_t Channels>
+void box_reduce_row(const byte* a, const byte* b, byte* dst, int src_width, simd_level level)
+{
+    const auto width = get_reduced_size(src_width);
+
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        x = box_reduce_row_avx2(a, b, dst, src_width, std::integral_constant<size_t, Channels>{});
+    }
+#endif
+
+    box_reduce_row_scalar<Channels>(a, b, dst, src_width, x, width);
+}
+
+/* Vertical [1 4 6 4 1] pass over five source rows into 16-bit sums; the largest sum, 16 * 255, fits. */
+inline void gaussian_column_scalar(const std::array<const byte*, 5>& rows, std::uint16_t* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        dst[i] = std::uint16_t(rows[0][i] + rows[4][i] + 4 * (rows[1][i] + rows[3][i]) + 6 * rows[2][i]);
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256i load_widened(const byte* ptr)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int gaussian_column_avx2(const std::array<const byte*, 5>& rows, std::uint16_t* dst, int count)
+{
+    int i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const auto outer = _mm256_add_epi16(load_widened(rows[0] + i), load_widened(rows[4] + i));
+        const auto inner = _mm256_slli_epi16(_mm256_add_epi16(load_widened(rows[1] + i), load_widened(rows[3] + i)), 2);
+        const auto center = load_widened(rows[2] + i);
+        const auto sum = _mm256_add_epi16(
+            _mm256_add_epi16(outer, inner),
+            _mm256_add_epi16(_mm256_slli_epi16(center, 2), _mm256_slli_epi16(center, 1)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), sum);
+    }
+
+    return i;
+}
+#endif
+
+/* Horizontal [1 4 6 4 1] pass at even columns with clamped borders; the total weight is 256. */
+template <size_t Channels>
+void gaussian_row(const std::uint16_t* src, byte* dst, int src_width)
+{
+    const auto width = get_reduced_size(src_width);
+    const auto at = [&](int x, size_t c) { return int(src[std::clamp(x, 0, src_width - 1) * Channels + c]); };
+
+    int x = 0;
+
+    for (; x < width && 2 * x - 2 < 0; ++x)
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[x * Channels + c] = byte((at(2 * x - 2, c) + 4 * at(2 * x - 1, c) + 6 * at(2 * x, c) + 4 * at(2 * x + 1, c) + at(2 * x + 2, c) + 128) >> 8);
+        }
+    }
+
+    for (; x < width && 2 * x + 2 < src_width; ++x)
+    {
+        const auto* p = src + (2 * x - 2) * Channels;
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[x * Channels + c] = byte((p[c] + 4 * p[Channels + c] + 6 * p[2 * Channels + c] + 4 * p[3 * Channels + c] + p[4 * Channels + c] + 128) >> 8);
+        }
+    }
+
+    for (; x < width; ++x)
+    {
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[x * Channels + c] = byte((at(2 * x - 2, c) + 4 * at(2 * x - 1, c) + 6 * at(2 * x, c) + 4 * at(2 * x + 1, c) + at(2 * x + 2, c) + 128) >> 8);
+        }
+    }
+}
+
+/* source and dest rows hold Channels bytes per pixel and must be contiguous. */
+template <size_t Channels, class SourceView, class DestView>
+void box_reduce(const SourceView& source, const DestView& dest, simd_level level = get_simd_level())
+{
+    for (int y = 0; y < dest.height(); ++y)
+    {
+        const auto y0 = 2 * y;
+        const auto y1 = std::min(y0 + 1, source.height() - 1);
+
+        box_reduce_row<Channels>(
+            reinterpret_cast<const byte*>(source.data({ 0, y0 })),
+            reinterpret_cast<const byte*>(source.data({ 0, y1 })),
+            reinterpret_cast<byte*>(dest.data({ 0, y })),
+            source.width(),
+            level);
+    }
+}
+
+template <size_t Channels, class SourceView, class DestView>
+void gaussian_reduce(const SourceView& source, const DestView& dest, simd_level level = get_simd_level())
+{
+    const auto count = source.width() * int(Channels);
+
+    std::vector<std::uint16_t> column(count);
+
+    for (int y = 0; y < dest.height(); ++y)
+    {
+        std::array<const byte*, 5> rows;
+
+        for (int k = 0; k < 5; ++k)
+        {
+            rows[k] = reinterpret_cast<const byte*>(source.data({ 0, std::clamp(2 * y + k - 2, 0, source.height() - 1) }));
+        }
+
+        int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+        if (level == simd_level::avx2)
+        {
+            i = gaussian_column_avx2(rows, column.data(), count);
+        }
+#endif
+
+        gaussian_column_scalar(rows, column.data(), i, count);
+
+        gaussian_row<Channels>(column.data(), reinterpret_cast<byte*>(dest.data({ 0, y })), source.width());
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_PYRAMID_REDUCTION_HPP_ */
@@ -0,0 +1,371 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_RESAMPLING_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_RESAMPLING_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class resampling_filter
+{
+    bilinear,
+    bicubic,
+    lanczos
+};
+
+namespace detail
+{
+
+template <class T>
+struct pixel_layout
+{
+    using channel_type = byte;
+    static constexpr size_t channels = bytes_per_pixel<T>::value;
+};
+
+template <>
+struct pixel_layout<float>
+{
+    using channel_type = float;
+    static constexpr size_t channels = 1;
+};
+
+inline float get_filter_support(resampling_filter filter)
+{
+    switch (filter)
+    {
+        case resampling_filter::bicubic:
+            return 2.F;
+
+        case resampling_filter::lanczos:
+            return 3.F;
+
+        default:
+            return 1.F;
+    }
+}
+
+inline float sinc(float x)
+{
+    if (x == 0.F)
+    {
+        return 1.F;
+    }
+
+    const auto v = x * 3.14159265358979F;
+    return std::sin(v) / v;
+}
+
+inline float get_filter_value(resampling_filter filter, float x)
+{
+    x = std::abs(x);
+
+    switch (filter)
+    {
+        /* Keys cubic with a = -0.5 */
+        case resampling_filter::bicubic:
+            return x < 1.F ? ((1.5F * x - 2.5F) * x) * x + 1.F
+                : x < 2.F ? ((-0.5F * x + 2.5F) * x - 4.F) * x + 2.F
+                : 0.F;
+
+        case resampling_filter::lanczos:
+            return x < 3.F ? sinc(x) * sinc(x / 3.F) : 0.F;
+
+        default:
+            return std::max(0.F, 1.F - x);
+    }
+}
+
+/* For each destination index, the first contributing source index and `taps` normalized weights (zero-padded);
+   when downscaling, the filter is stretched by the scale factor so that every source pixel contributes. */
+struct resampling_weights
+{
+    int taps = 0;
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<float> weights;
+
+    const float* at(int index) const
+    {
+        return weights.data() + size_t(index) * size_t(taps);
+    }
+};
+
+inline resampling_weights make_resampling_weights(int source_size, int dest_size, resampling_filter filter)
+{
+    EXPECTS(source_size > 0 && dest_size > 0, "resampling: empty size");
+
+    const auto scale = float(source_size) / float(dest_size);
+    const auto filter_scale = std::max(scale, 1.F);
+    const auto support = get_filter_support(filter) * filter_scale;
+
+    resampling_weights result;
+    result.taps = std::min(int(std::ceil(support)) * 2 + 1, source_size);
+    result.first.resize(dest_size);
+    result.count.resize(dest_size);
+    result.weights.assign(size_t(dest_size) * size_t(result.taps), 0.F);
+
+    for (int i = 0; i < dest_size; ++i)
+    {
+        const auto center = (float(i) + 0.5F) * scale;
+        const auto lower = std::max(int(center - support + 0.5F), 0);
+        const auto upper = std::min(std::max(int(center + support + 0.5F), lower + 1), source_size);
+        const auto count = std::min(upper - lower, result.taps);
+
+        auto* weights = result.weights.data() + size_t(i) * size_t(result.taps);
+
+        float total = 0.F;
+
+        for (int k = 0; k < count; ++k)
+        {
+            weights[k] = get_filter_value(filter, (float(lower + k) - center + 0.5F) / filter_scale);
+            total += weights[k];
+        }
+
+        if (total == 0.F)
+        {
+            weights[0] = total = 1.F;
+        }
+
+        for (int k = 0; k < count; ++k)
+        {
+            weights[k] /= total;
+        }
+
+        result.first[i] = lower;
+        result.count[i] = count;
+    }
+
+    return result;
+}
+
+/* Horizontal pass: one source row into dest_width * Channels floats. */
+template <size_t Channels, class T>
+void resample_row_scalar(const resampling_weights& weights, const T* src, float* dst, int begin, int end)
+{
+    for (int x = begin; x < end; ++x)
+    {
+        const auto* w = weights.at(x);
+        const auto* s = src + size_t(weights.first[x]) * Channels;
+
+        float sum[Channels] = {};
+
+        for (int k = 0; k < weights.count[x]; ++k, s += Channels)
+        {
+            for (size_t c = 0; c < Channels; ++c)
+            {
+                sum[c] += w[k] * float(s[c]);
+            }
+        }
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            dst[size_t(x) * Channels + c] = sum[c];
+        }
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+/* An rgba pixel fills one 128-bit register, so the taps are accumulated for all four channels at once. */
+inline int resample_row_sse2(const resampling_weights& weights, const byte* src, float* dst, int width)
+{
+    const auto zero = _mm_setzero_si128();
+
+    for (int x = 0; x < width; ++x)
+    {
+        const auto* w = weights.at(x);
+        const auto* s = src + size_t(weights.first[x]) * 4;
+
+        auto sum = _mm_setzero_ps();
+
+        for (int k = 0; k < weights.count[x]; ++k, s += 4)
+        {
+            int packed;
+            std::memcpy(&packed, s, 4);
+
+            const auto pixel = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[k]), pixel));
+        }
+
+        _mm_storeu_ps(dst + size_t(x) * 4, sum);
+    }
+
+    return width;
+}
+#endif
+
+template <size_t Channels, class T>
+void resample_row(const resampling_weights& weights, const T* src, float* dst, simd_level level)
+{
+    const auto width = int(weights.first.size());
+
+    int x = 0;
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+    if constexpr (Channels == 4 && std::is_same_v<T, byte>)
+    {
+        if (level != simd_level::none)
+        {
+            x = resample_row_sse2(weights, src, dst, width);
+        }
+    }
+#endif
+
+    resample_row_scalar<Channels>(weights, src, dst, x, width);
+}
+
+inline void store_channel(float value, byte& dst)
+{
+    dst = byte(std::min(std::max(value + 0.5F, 0.F), 255.F));
+}
+
+inline void store_channel(float value, float& dst)
+{
+    dst = value;
+}
+
+/* Vertical pass: weighted sum of cached rows, `count` floats each. */
+template <class T>
+void combine_rows_scalar(const float* const* rows, const float* weights, int taps, T* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        float sum = 0.F;
+
+        for (int k = 0; k < taps; ++k)
+        {
+            sum += weights[k] * rows[k][i];
+        }
+
+        store_channel(sum, dst[i]);
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256 combine_rows_avx2(const float* const* rows, const float* weights, int taps, int i)
+{
+    auto sum = _mm256_setzero_ps();
+
+    for (int k = 0; k < taps; ++k)
+    {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(rows[k] + i)));
+    }
+
+    return sum;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int combine_rows_avx2(const float* const* rows, const float* weights, int taps, byte* dst, int count)
+{
+    const auto half = _mm256_set1_ps(0.5F);
+    const auto zero = _mm256_setzero_ps();
+    const auto max = _mm256_set1_ps(255.F);
+
+    int i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const auto lo = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_add_ps(combine_rows_avx2(rows, weights, taps, i), half), zero), max));
+        const auto hi = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_add_ps(combine_rows_avx2(rows, weights, taps, i + 8), half), zero), max));
+
+        /* packs interleave the 128-bit lanes, so the result is put back in order with a permute */
+        const auto words = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        const auto bytes = _mm256_packus_epi16(words, words);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(_mm256_permute4x64_epi64(bytes, 0x08)));
+    }
+
+    return i;
+}
+
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int combine_rows_avx2(const float* const* rows, const float* weights, int taps, float* dst, int count)
+{
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, combine_rows_avx2(rows, weights, taps, i));
+    }
+
+    return i;
+}
+#endif
+
+template <class T>
+void combine_rows(const float* const* rows, const float* weights, int taps, T* dst, int count, simd_level level)
+{
+    int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        i = combine_rows_avx2(rows, weights, taps, dst, count);
+    }
+#endif
+
+    combine_rows_scalar(rows, weights, taps, dst, i, count);
+}
+
+/* Resamples destination rows [begin, end); horizontally resampled source rows are kept in a ring sized for the vertical taps,
+   so each source row is resampled once per band. Rows of source and dest must be contiguous. */
+template <class SourceView, class DestView>
+void resample_rows(
+    const resampling_weights& horizontal,
+    const resampling_weights& vertical,
+    const SourceView& source,
+    const DestView& dest,
+    int begin,
+    int end,
+    simd_level level)
+{
+    using layout = pixel_layout<typename DestView::value_type>;
+    using channel_type = typename layout::channel_type;
+
+    const auto count = dest.width() * int(layout::channels);
+    const auto capacity = vertical.taps;
+
+    std::vector<float> cache(size_t(count) * size_t(capacity));
+    std::vector<int> cached(capacity, -1);
+    std::vector<const float*> rows(capacity);
+
+    for (int y = begin; y < end; ++y)
+    {
+        const auto first = vertical.first[y];
+        const auto taps = vertical.count[y];
+
+        for (int k = 0; k < taps; ++k)
+        {
+            const auto row = first + k;
+            const auto slot = row % capacity;
+            auto* ptr = cache.data() + size_t(slot) * size_t(count);
+
+            if (cached[slot] != row)
+            {
+                resample_row<layout::channels>(horizontal, reinterpret_cast<const channel_type*>(source.data({ 0, row })), ptr, level);
+                cached[slot] = row;
+            }
+
+            rows[k] = ptr;
+        }
+
+        combine_rows(rows.data(), vertical.at(y), taps, reinterpret_cast<channel_type*>(dest.data({ 0, y })), count, level);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_RESAMPLING_HPP_ */
@@ -0,0 +1,143 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_ROW_ACCESS_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_ROW_ACCESS_HPP_
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+template <class View>
+bool is_contiguous_row(const View& view)
+{
+    return view.stride()[0] == sizeof(typename View::value_type);
+}
+
+template <class SourceView, class DestView>
+void copy_view(const SourceView& source, const DestView& dest)
+{
+    using value_type = typename DestView::value_type;
+
+    constexpr auto pixel_size = std::ptrdiff_t(bytes_per_pixel<value_type>::value);
+
+    EXPECTS(source.size() == dest.size(), "copy_view: size mismatch");
+
+    const bool contiguous = source.stride()[0] == pixel_size && dest.stride()[0] == pixel_size;
+
+    for (int y = 0; y < dest.height(); ++y)
+    {
+        if (contiguous)
+        {
+            std::memcpy(reinterpret_cast<byte*>(dest.data({ 0, y })), reinterpret_cast<const byte*>(source.data({ 0, y })), size_t(dest.width() * pixel_size));
+        }
+        else
+        {
+            for (int x = 0; x < dest.width(); ++x)
+            {
+                dest[{ x, y }] = source[{ x, y }];
+            }
+        }
+    }
+}
+
+/* Gives contiguous pointers to the rows of a byte view, copying strided rows into a ring of `capacity` buffers. */
+class source_rows
+{
+public:
+    source_rows(byte_image::const_view_type source, int capacity)
+        : _source(source)
+        , _contiguous(is_contiguous_row(source))
+        , _rows(_contiguous ? 0 : capacity)
+        , _indices(_rows.size(), -1)
+    {
+        for (auto& row : _rows)
+        {
+            row.resize(source.width());
+        }
+    }
+
+    const byte* operator [](int y)
+    {
+        if (_contiguous)
+        {
+            return _source.data({ 0, y });
+        }
+
+        const auto slot = size_t(y) % _rows.size();
+        auto& row = _rows[slot];
+
+        if (_indices[slot] != y)
+        {
+            const auto step = _source.stride()[0];
+            const auto* ptr = _source.data({ 0, y });
+
+            for (int x = 0; x < _source.width(); ++x, ptr += step)
+            {
+                row[x] = *ptr;
+            }
+
+            _indices[slot] = y;
+        }
+
+        return row.data();
+    }
+
+private:
+    byte_image::const_view_type _source;
+    bool _contiguous;
+    std::vector<std::vector<byte>> _rows;
+    std::vector<int> _indices;
+};
+
+/* Gives a contiguous pointer to write a row of a byte view; strided rows are written back on commit. */
+class dest_row
+{
+public:
+    dest_row(byte_image::view_type dest, int width)
+        : _dest(dest)
+        , _contiguous(is_contiguous_row(dest))
+        , _buffer(_contiguous ? 0 : width)
+        , _width(width)
+    {
+    }
+
+    byte* get(int y)
+    {
+        return _contiguous ? _dest.data({ 0, y }) : _buffer.data();
+    }
+
+    void commit(int y)
+    {
+        if (_contiguous)
+        {
+            return;
+        }
+
+        const auto step = _dest.stride()[0];
+        auto* ptr = _dest.data({ 0, y });
+
+        for (int x = 0; x < _width; ++x, ptr += step)
+        {
+            *ptr = _buffer[x];
+        }
+    }
+
+private:
+    byte_image::view_type _dest;
+    bool _contiguous;
+    std::vector<byte> _buffer;
+    int _width;
+};
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_ROW_ACCESS_HPP_ */
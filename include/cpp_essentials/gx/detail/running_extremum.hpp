@@ -0,0 +1,275 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_RUNNING_EXTREMUM_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_RUNNING_EXTREMUM_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+struct max_op
+{
+    static constexpr byte identity = 0;
+
+    byte operator ()(byte lhs, byte rhs) const
+    {
+        return lhs < rhs ? rhs : lhs;
+    }
+};
+
+struct min_op
+{
+    static constexpr byte identity = 255;
+
+    byte operator ()(byte lhs, byte rhs) const
+    {
+        return rhs < lhs ? rhs : lhs;
+    }
+};
+
+template <class Op>
+void combine_rows(byte* out, const byte* lhs, const byte* rhs, int width, Op op)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        out[x] = op(lhs[x], rhs[x]);
+    }
+}
+
+/* van Herk / Gil-Werman: out[x] = op(in[x], ..., in[x + length - 1]) with three comparisons per element regardless of length. */
+template <class Op>
+void running_extremum(const byte* in, int width, int length, byte* out, std::vector<byte>& prefix, std::vector<byte>& suffix, Op op)
+{
+    prefix.resize(width);
+    suffix.resize(width);
+
+    for (int x = 0; x < width; ++x)
+    {
+        prefix[x] = x % length == 0 ? in[x] : op(prefix[x - 1], in[x]);
+    }
+
+    for (int x = width - 1; x >= 0; --x)
+    {
+        suffix[x] = (x == width - 1 || (x + 1) % length == 0) ? in[x] : op(suffix[x + 1], in[x]);
+    }
+
+    for (int x = 0; x + length <= width; ++x)
+    {
+        out[x] = op(suffix[x], prefix[x + length - 1]);
+    }
+}
+
+/* The same recurrence applied to whole rows: dest row y receives op over rows y .. y + length - 1 of `rows`. */
+template <class Rows, class Op>
+void running_extremum_vertical(Rows&& rows, int width, int height, int length, dest_row& dest, Op op)
+{
+    const auto out_height = height - length + 1;
+
+    std::vector<byte> suffix(size_t(length) * width);
+    std::vector<byte> prefix(width);
+
+    for (int block = 0; block < out_height; block += length)
+    {
+        const auto block_end = std::min(block + length, height);
+
+        std::copy_n(rows(block_end - 1), width, &suffix[size_t(block_end - 1 - block) * width]);
+
+        for (int y = block_end - 2; y >= block; --y)
+        {
+            combine_rows(&suffix[size_t(y - block) * width], rows(y), &suffix[size_t(y - block + 1) * width], width, op);
+        }
+
+        std::copy_n(&suffix[0], width, dest.get(block));
+        dest.commit(block);
+
+        for (int t = 1; t < length && block + t < out_height; ++t)
+        {
+            const auto* row = rows(block + length + t - 1);
+
+            if (t == 1)
+            {
+                std::copy_n(row, width, prefix.data());
+            }
+            else
+            {
+                combine_rows(prefix.data(), prefix.data(), row, width, op);
+            }
+
+            combine_rows(dest.get(block + t), &suffix[size_t(t) * width], prefix.data(), width, op);
+            dest.commit(block + t);
+        }
+    }
+}
+
+struct mask_run
+{
+    int y;
+    int x;
+    int length;
+};
+
+inline std::vector<mask_run> get_mask_runs(byte_image::const_view_type mask)
+{
+    std::vector<mask_run> result;
+
+    for (int y = 0; y < mask.height(); ++y)
+    {
+        int x = 0;
+
+        while (x < mask.width())
+        {
+            if (mask[{ x, y }] == 0)
+            {
+                ++x;
+                continue;
+            }
+
+            const auto start = x;
+
+            while (x < mask.width() && mask[{ x, y }] != 0)
+            {
+                ++x;
+            }
+
+            result.push_back({ y, start, x - start });
+        }
+    }
+
+    return result;
+}
+
+inline bool is_box(const std::vector<mask_run>& runs, const size_type& size)
+{
+    return int(runs.size()) == size.y()
+        && std::all_of(runs.begin(), runs.end(), [&](const mask_run& run) { return run.x == 0 && run.length == size.x(); });
+}
+
+template <class Op>
+void box_extremum(byte_image::const_view_type source, byte_image::view_type dest, const size_type& box_size, Op op)
+{
+    const auto width = source.width() - box_size.x() + 1;
+
+    std::vector<byte> horizontal(size_t(width) * source.height());
+    std::vector<byte> prefix;
+    std::vector<byte> suffix;
+
+    source_rows rows{ source, 1 };
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        running_extremum(rows[y], source.width(), box_size.x(), &horizontal[size_t(y) * width], prefix, suffix, op);
+    }
+
+    dest_row out{ dest, width };
+
+    running_extremum_vertical(
+        [&](int y) { return &horizontal[size_t(y) * width]; },
+        width,
+        source.height(),
+        box_size.y(),
+        out,
+        op);
+}
+
+/* Arbitrary binary masks are treated as a union of horizontal runs; every distinct run length gets one running extremum per source row. */
+template <class Op>
+void runs_extremum(byte_image::const_view_type source, byte_image::view_type dest, const std::vector<mask_run>& runs, const size_type& mask_size, Op op)
+{
+    const auto size = source.size() - mask_size + size_type{ 1, 1 };
+
+    std::vector<int> lengths;
+
+    for (const auto& run : runs)
+    {
+        lengths.push_back(run.length);
+    }
+
+    std::sort(lengths.begin(), lengths.end());
+    lengths.erase(std::unique(lengths.begin(), lengths.end()), lengths.end());
+
+    const auto capacity = mask_size.y();
+
+    std::vector<std::vector<byte>> cache(lengths.size() * capacity);
+    std::vector<int> cached_rows(cache.size(), -1);
+    std::vector<byte> prefix;
+    std::vector<byte> suffix;
+
+    source_rows rows{ source, capacity };
+    dest_row out{ dest, size.x() };
+
+    auto get_row = [&](size_t length_index, int y) -> const byte*
+    {
+        const auto slot = length_index * capacity + size_t(y) % capacity;
+        auto& row = cache[slot];
+
+        if (cached_rows[slot] != y)
+        {
+            row.resize(source.width() - lengths[length_index] + 1);
+            running_extremum(rows[y], source.width(), lengths[length_index], row.data(), prefix, suffix, op);
+            cached_rows[slot] = y;
+        }
+
+        return row.data();
+    };
+
+    std::vector<size_t> length_indices;
+
+    for (const auto& run : runs)
+    {
+        length_indices.push_back(std::lower_bound(lengths.begin(), lengths.end(), run.length) - lengths.begin());
+    }
+
+    for (int y = 0; y < size.y(); ++y)
+    {
+        auto* ptr = out.get(y);
+
+        std::fill_n(ptr, size.x(), Op::identity);
+
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            combine_rows(ptr, ptr, get_row(length_indices[i], y + runs[i].y) + runs[i].x, size.x(), op);
+        }
+
+        out.commit(y);
+    }
+}
+
+template <class Op>
+void mask_extremum(byte_image::const_view_type source, byte_image::view_type dest, byte_image::const_view_type mask, Op op)
+{
+    const auto size = source.size() - mask.size() + size_type{ 1, 1 };
+
+    if (size.x() <= 0 || size.y() <= 0)
+    {
+        return;
+    }
+
+    const auto runs = get_mask_runs(mask);
+
+    if (runs.empty())
+    {
+        dest.region({ geo::zeros, size }) = Op::identity;
+    }
+    else if (is_box(runs, mask.size()))
+    {
+        box_extremum(source, dest, mask.size(), op);
+    }
+    else
+    {
+        runs_extremum(source, dest, runs, mask.size(), op);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_RUNNING_EXTREMUM_HPP_ */
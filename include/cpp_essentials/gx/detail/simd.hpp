@@ -0,0 +1,98 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_SIMD_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_SIMD_HPP_
+
+#pragma once
+
+#if !defined(CPP_ESSENTIALS_GX_NO_SIMD)
+#  if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define CPP_ESSENTIALS_GX_SSE2 1
+#    if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#      define CPP_ESSENTIALS_GX_AVX2 1
+#    endif
+#  endif
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+#  include <emmintrin.h>
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define CPP_ESSENTIALS_GX_TARGET(FEATURES) __attribute__((target(FEATURES)))
+#else
+#  define CPP_ESSENTIALS_GX_TARGET(FEATURES)
+#endif
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+enum class simd_level
+{
+    none,
+    sse2,
+    avx2,
+};
+
+inline simd_level detect_simd_level()
+{
+#if defined(CPP_ESSENTIALS_GX_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return simd_level::avx2;
+    }
+#elif defined(CPP_ESSENTIALS_GX_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+
+    const bool os_uses_xsave = (info[2] & (1 << 27)) != 0;
+    const bool has_avx = (info[2] & (1 << 28)) != 0;
+
+    if (os_uses_xsave && has_avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+
+        if ((info[1] & (1 << 5)) != 0)
+        {
+            return simd_level::avx2;
+        }
+    }
+#endif
+
+#if defined(CPP_ESSENTIALS_GX_SSE2)
+    return simd_level::sse2;
+#else
+    return simd_level::none;
+#endif
+}
+
+inline simd_level get_simd_level()
+{
+    static const simd_level result = detect_simd_level();
+    return result;
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+/* floor(x / 255) for any 16-bit x */
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline __m256i div255_epu16(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16(short(0x8081))), 7);
+}
+#endif
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_SIMD_HPP_ */
@@ -0,0 +1,255 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_SLIDING_HISTOGRAM_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_SLIDING_HISTOGRAM_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+#include <cpp_essentials/gx/detail/running_extremum.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* Two-level (16 coarse x 16 fine bins) histogram: rank queries touch at most 32 bins. */
+template <class Count>
+struct sliding_histogram
+{
+    std::array<Count, 256> fine;
+    std::array<Count, 16> coarse;
+
+    sliding_histogram()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        fine.fill(0);
+        coarse.fill(0);
+    }
+
+    void add(byte value)
+    {
+        ++fine[value];
+        ++coarse[value >> 4];
+    }
+
+    void remove(byte value)
+    {
+        --fine[value];
+        --coarse[value >> 4];
+    }
+
+    void add(const sliding_histogram& other)
+    {
+        for (size_t i = 0; i < fine.size(); ++i)
+        {
+            fine[i] += other.fine[i];
+        }
+
+        for (size_t i = 0; i < coarse.size(); ++i)
+        {
+            coarse[i] += other.coarse[i];
+        }
+    }
+
+    void subtract(const sliding_histogram& other)
+    {
+        for (size_t i = 0; i < fine.size(); ++i)
+        {
+            fine[i] -= other.fine[i];
+        }
+
+        for (size_t i = 0; i < coarse.size(); ++i)
+        {
+            coarse[i] -= other.coarse[i];
+        }
+    }
+
+    /* Value of the element with the given 0-based rank. */
+    byte nth(size_t index) const
+    {
+        size_t sum = 0;
+        size_t bin = 0;
+
+        while (bin + 1 < coarse.size() && sum + coarse[bin] <= index)
+        {
+            sum += coarse[bin++];
+        }
+
+        auto value = bin * 16;
+
+        while (value + 1 < fine.size() && sum + fine[value] <= index)
+        {
+            sum += fine[value++];
+        }
+
+        return byte(value);
+    }
+};
+
+inline size_t get_percentile_index(size_t count, int rank)
+{
+    const auto index = count * size_t(std::max(rank, 0)) / 100;
+    return std::min(index, count - 1);
+}
+
+/* Perreault & Hebert: one histogram per column slides down, the kernel histogram slides right by adding and removing whole columns. */
+template <class Count>
+void box_percentile(byte_image::const_view_type source, byte_image::view_type dest, const size_type& box_size, int rank)
+{
+    const auto size = source.size() - box_size + size_type{ 1, 1 };
+    const auto index = get_percentile_index(size_t(box_size.x()) * box_size.y(), rank);
+
+    std::vector<sliding_histogram<Count>> columns(source.width());
+    sliding_histogram<Count> kernel;
+
+    source_rows rows{ source, box_size.y() + 1 };
+    dest_row out{ dest, size.x() };
+
+    for (int y = 0; y < box_size.y(); ++y)
+    {
+        const auto* row = rows[y];
+
+        for (int x = 0; x < source.width(); ++x)
+        {
+            columns[x].add(row[x]);
+        }
+    }
+
+    for (int y = 0; y < size.y(); ++y)
+    {
+        if (y > 0)
+        {
+            const auto* removed = rows[y - 1];
+            const auto* added = rows[y + box_size.y() - 1];
+
+            for (int x = 0; x < source.width(); ++x)
+            {
+                columns[x].remove(removed[x]);
+                columns[x].add(added[x]);
+            }
+        }
+
+        kernel.clear();
+
+        for (int x = 0; x < box_size.x(); ++x)
+        {
+            kernel.add(columns[x]);
+        }
+
+        auto* ptr = out.get(y);
+
+        ptr[0] = kernel.nth(index);
+
+        for (int x = 1; x < size.x(); ++x)
+        {
+            kernel.subtract(columns[x - 1]);
+            kernel.add(columns[x + box_size.x() - 1]);
+
+            ptr[x] = kernel.nth(index);
+        }
+
+        out.commit(y);
+    }
+}
+
+/* Huang: for arbitrary masks the histogram slides right by removing and adding one pixel per mask run. */
+template <class Count>
+void runs_percentile(byte_image::const_view_type source, byte_image::view_type dest, const std::vector<mask_run>& runs, const size_type& mask_size, int rank)
+{
+    const auto size = source.size() - mask_size + size_type{ 1, 1 };
+
+    size_t count = 0;
+
+    for (const auto& run : runs)
+    {
+        count += run.length;
+    }
+
+    const auto index = get_percentile_index(count, rank);
+
+    sliding_histogram<Count> kernel;
+
+    source_rows rows{ source, mask_size.y() };
+    dest_row out{ dest, size.x() };
+
+    std::vector<const byte*> run_rows(runs.size());
+
+    for (int y = 0; y < size.y(); ++y)
+    {
+        kernel.clear();
+
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            run_rows[i] = rows[y + runs[i].y] + runs[i].x;
+
+            for (int x = 0; x < runs[i].length; ++x)
+            {
+                kernel.add(run_rows[i][x]);
+            }
+        }
+
+        auto* ptr = out.get(y);
+
+        ptr[0] = kernel.nth(index);
+
+        for (int x = 1; x < size.x(); ++x)
+        {
+            for (size_t i = 0; i < runs.size(); ++i)
+            {
+                kernel.remove(run_rows[i][x - 1]);
+                kernel.add(run_rows[i][x - 1 + runs[i].length]);
+            }
+
+            ptr[x] = kernel.nth(index);
+        }
+
+        out.commit(y);
+    }
+}
+
+inline void mask_percentile(byte_image::const_view_type source, byte_image::view_type dest, byte_image::const_view_type mask, int rank)
+{
+    const auto size = source.size() - mask.size() + size_type{ 1, 1 };
+
+    if (size.x() <= 0 || size.y() <= 0)
+    {
+        return;
+    }
+
+    const auto runs = get_mask_runs(mask);
+    const auto small_counts = mask.volume() <= std::numeric_limits<std::uint16_t>::max();
+
+    if (runs.empty())
+    {
+        dest.region({ geo::zeros, size }) = byte(0);
+    }
+    else if (is_box(runs, mask.size()))
+    {
+        small_counts
+            ? box_percentile<std::uint16_t>(source, dest, mask.size(), rank)
+            : box_percentile<std::uint32_t>(source, dest, mask.size(), rank);
+    }
+    else
+    {
+        small_counts
+            ? runs_percentile<std::uint16_t>(source, dest, runs, mask.size(), rank)
+            : runs_percentile<std::uint32_t>(source, dest, runs, mask.size(), rank);
+    }
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_SLIDING_HISTOGRAM_HPP_ */
@@ -0,0 +1,119 @@
+#ifndef CPP_ESSENTIALS_GX_DETAIL_SPAN_OPERATIONS_HPP_
+#define CPP_ESSENTIALS_GX_DETAIL_SPAN_OPERATIONS_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/simd.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+/* (color * alpha + dst * (255 - alpha) + 128) / 255 */
+inline byte blend_channel(byte color, byte dst, byte alpha)
+{
+    return byte((color * alpha + dst * (255 - alpha) + 128) / 255);
+}
+
+/* A span of a uniform color, repeated to 96 bytes so that it lines up with 32-byte vectors for 1, 3 and 4 byte pixels. */
+struct span_pattern
+{
+    static constexpr int size = 96;
+
+    byte data[size];
+
+    span_pattern(const byte* color, size_t pixel_size)
+    {
+        std::memcpy(data, color, pixel_size);
+
+        /* the copied prefix is always a whole number of pixels, so doubling it tiles the color */
+        for (size_t filled = pixel_size; filled < size_t(size); filled *= 2)
+        {
+            std::memcpy(data + filled, data, std::min(filled, size_t(size) - filled));
+        }
+    }
+};
+
+/* count is the number of bytes of a contiguous span of pixels starting at dst */
+inline void fill_span(const span_pattern& pattern, byte* dst, int count)
+{
+    for (; count > span_pattern::size; count -= span_pattern::size, dst += span_pattern::size)
+    {
+        std::memcpy(dst, pattern.data, span_pattern::size);
+    }
+
+    std::memcpy(dst, pattern.data, size_t(count));
+}
+
+inline void blend_span_scalar(const span_pattern& pattern, byte alpha, byte* dst, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        dst[i] = blend_channel(pattern.data[i % span_pattern::size], dst[i], alpha);
+    }
+}
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+CPP_ESSENTIALS_GX_TARGET("avx2")
+inline int blend_span_avx2(const span_pattern& pattern, byte alpha, byte* dst, int count)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto inverse = _mm256_set1_epi16(short(255 - alpha));
+
+    /* color * alpha + 128 for the three phases of the pattern */
+    __m256i lo[3];
+    __m256i hi[3];
+
+    for (int k = 0; k < 3; ++k)
+    {
+        const auto color = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.data + 32 * k));
+        const auto a = _mm256_set1_epi16(short(alpha));
+        const auto round = _mm256_set1_epi16(128);
+
+        lo[k] = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(color, zero), a), round);
+        hi[k] = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(color, zero), a), round);
+    }
+
+    int i = 0;
+
+    for (int k = 0; i + 32 <= count; i += 32, k = k == 2 ? 0 : k + 1)
+    {
+        const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+
+        const auto l = div255_epu16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(value, zero), inverse), lo[k]));
+        const auto h = div255_epu16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(value, zero), inverse), hi[k]));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(l, h));
+    }
+
+    return i;
+}
+#endif
+
+/* count is the number of bytes of a contiguous span of pixels starting at dst */
+inline void blend_span(const span_pattern& pattern, byte alpha, byte* dst, int count, simd_level level = get_simd_level())
+{
+    int i = 0;
+
+#if defined(CPP_ESSENTIALS_GX_AVX2)
+    if (level == simd_level::avx2)
+    {
+        i = blend_span_avx2(pattern, alpha, dst, count);
+    }
+#endif
+
+    blend_span_scalar(pattern, alpha, dst, i, count);
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DETAIL_SPAN_OPERATIONS_HPP_ */
@@ -0,0 +1,132 @@
+#ifndef CPP_ESSENTIALS_GX_DISTANCE_TRANSFORM_HPP_
+#define CPP_ESSENTIALS_GX_DISTANCE_TRANSFORM_HPP_
+
+#pragma once
+
+#include <cpp_essentials/core/assertions.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/distance_transform.hpp>
+#include <cpp_essentials/gx/detail/morphological_operations.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+inline void distance_transform(byte_image::const_view_type source, image<float>& dest, bool feature_is_zero)
+{
+    column_distances(source, dest, feature_is_zero, 0, source.width());
+
+    lower_envelope envelope{ source.width() };
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        row_distances(dest.data({ 0, y }), source.width(), envelope);
+    }
+}
+
+inline void distance_transform(const execution::parallel_policy& policy, byte_image::const_view_type source, image<float>& dest, bool feature_is_zero)
+{
+    parallel_for_bands(policy, source.width(), 64, [&](int begin, int end)
+    {
+        column_distances(source, dest, feature_is_zero, begin, end);
+    });
+
+    parallel_for_bands(policy, source.height(), 16, [&](int begin, int end)
+    {
+        lower_envelope envelope{ source.width() };
+
+        for (auto y = begin; y < end; ++y)
+        {
+            row_distances(dest.data({ 0, y }), source.width(), envelope);
+        }
+    });
+}
+
+/* Pixels closer than radius + 0.5 to a feature pixel, which is what an ellipse element of size 2 * radius + 1 from
+   create_structuring_element covers, become features. */
+inline void threshold_distances(const image<float>& distances, byte_image::view_type dest, int radius, bool feature_is_zero)
+{
+    EXPECTS(distances.size() == dest.size(), "disk morphology: size mismatch");
+    EXPECTS(radius >= 0, "disk morphology: negative radius");
+
+    const auto limit = float(radius) + 0.5F;
+    const byte near_value = feature_is_zero ? 0 : 255;
+    const byte far_value = feature_is_zero ? 255 : 0;
+
+    dest_row output{ dest, dest.width() };
+
+    for (int y = 0; y < dest.height(); ++y)
+    {
+        const auto* row = distances.data({ 0, y });
+        auto* out = output.get(y);
+
+        for (int x = 0; x < dest.width(); ++x)
+        {
+            out[x] = row[x] < limit ? near_value : far_value;
+        }
+
+        output.commit(y);
+    }
+}
+
+struct distance_transform_fn
+{
+    /* Euclidean distance from every pixel to the nearest zero pixel; infinity when there is none. */
+    image<float> operator ()(byte_image::const_view_type mask) const
+    {
+        image<float> result{ mask.size() };
+        distance_transform(mask, result, true);
+        return result;
+    }
+
+    /* The column phase runs in bands of columns and the row phase in bands of rows. */
+    image<float> operator ()(const execution::parallel_policy& policy, byte_image::const_view_type mask) const
+    {
+        image<float> result{ mask.size() };
+        distance_transform(policy, mask, result, true);
+        return result;
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto distance_transform = detail::distance_transform_fn{};
+
+/* Erosion and dilation of a mask by a disk of any radius in linear time: the result equals convolving with
+   erosion / dilation of create_structuring_element({ 2 * radius + 1, 2 * radius + 1 }, structuring_element::ellipse) wherever
+   the element lies inside the image, and is computed for the whole image. Pixels outside the image are ignored. */
+inline void erode_disk(byte_mask::const_view_type source, byte_mask::view_type dest, int radius)
+{
+    image<float> distances{ source.size() };
+    detail::distance_transform(source, distances, true);
+    detail::threshold_distances(distances, dest, radius, true);
+}
+
+inline void erode_disk(const execution::parallel_policy& policy, byte_mask::const_view_type source, byte_mask::view_type dest, int radius)
+{
+    image<float> distances{ source.size() };
+    detail::distance_transform(policy, source, distances, true);
+    detail::threshold_distances(distances, dest, radius, true);
+}
+
+inline void dilate_disk(byte_mask::const_view_type source, byte_mask::view_type dest, int radius)
+{
+    image<float> distances{ source.size() };
+    detail::distance_transform(source, distances, false);
+    detail::threshold_distances(distances, dest, radius, false);
+}
+
+inline void dilate_disk(const execution::parallel_policy& policy, byte_mask::const_view_type source, byte_mask::view_type dest, int radius)
+{
+    image<float> distances{ source.size() };
+    detail::distance_transform(policy, source, distances, false);
+    detail::threshold_distances(distances, dest, radius, false);
+}
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_DISTANCE_TRANSFORM_HPP_ */
@@ -3,7 +3,9 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #include <cpp_essentials/arrays/array_view.hpp>
 #include <cpp_essentials/arrays/array.hpp>
@@ -11,60 +13,137 @@
 
 #include <cpp_essentials/gx/defs.hpp>
 #include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/font8x8.hpp>
+#include <cpp_essentials/gx/detail/polygon_rasterizer.hpp>
+#include <cpp_essentials/gx/detail/span_operations.hpp>
 
 namespace cpp_essentials::gx
 {
 
+struct text_label
+{
+    std::string text;
+    point location;
+};
+
 template <class Color>
 class drawing_context
 {
 public:
     using color_type = Color;
 
-    drawing_context(typename arrays::array<color_type, 2>::view_type image)
+    /* origin is the position of the image's top-left pixel in drawing coordinates, e.g. the offset of a tile of a tiled_image */
+    drawing_context(typename arrays::array<color_type, 2>::view_type image, const point& origin = {})
         : _image(image)
-        , _bounds(_image.bounds())
+        , _origin(origin)
     {
     }
 
     drawing_context& draw_pixel(const point& point, color_type color, byte alpha = 255)
     {
-        typename arrays::array<color_type, 2>::location_type loc = point;
-        
-        if (geo::contains(_bounds, loc))
+        if (contains(point))
         {
-            _image[loc] = color_type(core::lerp(alpha / 255.0F, _image[loc], color));
+            blend_pixel(point, color, alpha);
         }
 
         return *this;
     }
 
+    /* Walks the same pixels as bresenham_line and writes each row's run as one span. The segment is clipped first: the walk
+       starts at its first step inside the image and stops after the last one. */
     drawing_context& draw_line(const point& start, const point& end, color_type color, byte alpha = 255)
     {
-        bresenham_line(
-            start,
-            end,
-            [&](auto&& pos) { draw_pixel(pos, color, alpha); });
+        if (alpha == 0 || get_clipping(detail::get_bounds(start, end, 0)) == clipping::outside)
+        {
+            return *this;
+        }
+
+        const detail::bresenham_steps line{ start, end };
+        const auto region = image_region();
+        const auto steps = line.visible(region.lower(), region.upper());
+
+        if (steps.first > steps.second)
+        {
+            return *this;
+        }
+
+        const auto pattern = make_pattern(color);
+
+        const auto& dist = line.dist;
+        const auto& dir = line.dir;
+
+        auto err = line.error(steps.first);
+        auto cur = line.position(steps.first);
+
+        auto run_y = cur.y();
+        auto run_begin = cur.x();
+        auto run_end = cur.x();
+
+        for (auto step = steps.first; step < steps.second; ++step)
+        {
+            const auto e = err;
+
+            if (e > -dist.x())
+            {
+                err -= dist.y();
+                cur[0] += dir.x();
+            }
+
+            if (e < dist.y())
+            {
+                err += dist.x();
+                cur[1] += dir.y();
+            }
+
+            if (cur.y() == run_y)
+            {
+                run_begin = std::min(run_begin, cur.x());
+                run_end = std::max(run_end, cur.x());
+            }
+            else
+            {
+                draw_scanline(run_y, run_begin, run_end, color, alpha, pattern);
+
+                run_y = cur.y();
+                run_begin = run_end = cur.x();
+            }
+        }
+
+        draw_scanline(run_y, run_begin, run_end, color, alpha, pattern);
 
         return *this;
     }
 
     drawing_context& draw_line_smooth(const point& start, const point& end, color_type color, byte alpha = 255)
     {
+        const auto clip = get_clipping(detail::get_bounds(start, end, 1));
+
+        if (alpha == 0 || clip == clipping::outside)
+        {
+            return *this;
+        }
+
         xiaolin_wu_line(
             start,
             end,
-            [&](auto&& pos, auto r) { draw_pixel(pos, color, to_byte(alpha * r)); });
+            [&](auto&& pos, auto r) { plot(clip, pos, color, to_byte(alpha * r)); });
 
         return *this;
-    }    
+    }
 
     drawing_context& draw_circle(const point& center, int radius, color_type color, byte alpha = 255)
     {
+        const auto clip = get_clipping(detail::get_bounds(center, center, std::abs(radius)));
+
+        if (alpha == 0 || clip == clipping::outside)
+        {
+            return *this;
+        }
+
         bresenham_circle(
             center,
             radius,
-            [&](auto&& pos) { draw_pixel(pos, color, alpha); });
+            [&](auto&& pos) { plot(clip, pos, color, alpha); });
 
         return *this;
     }
@@ -99,56 +178,57 @@ public:
         return draw_circle(shape.center(), shape.radius(), color, alpha);
     }
 
+    /* The rect is clamped to the image once; the rows that remain are drawn without further clipping. */
     drawing_context& fill(const rect& rect, color_type color, byte alpha = 255)
     {
-        for (auto y = geo::top(rect); y <= geo::bottom(rect); ++y)
+        const auto region = image_region();
+
+        const auto x0 = std::max(geo::left(rect), region.lower().x());
+        const auto x1 = std::min(geo::right(rect), region.upper().x() - 1);
+        const auto y0 = std::max(geo::top(rect), region.lower().y());
+        const auto y1 = std::min(geo::bottom(rect), region.upper().y() - 1);
+
+        if (alpha == 0 || x0 > x1)
+        {
+            return *this;
+        }
+
+        const auto pattern = make_pattern(color);
+
+        for (auto y = y0; y <= y1; ++y)
         {
-            draw_scanline(y, geo::left(rect), geo::right(rect), color, alpha);
+            draw_span(y - _origin.y(), x0 - _origin.x(), x1 - _origin.x() + 1, color, alpha, pattern);
         }
 
         return *this;
     }
 
     template <class T, size_t N>
-    drawing_context& fill(const geo::vertex_array<T, 2, N, geo::detail::polygon_tag>& shape, color_type color, byte alpha = 255)
+    drawing_context& fill(const geo::vertex_array<T, 2, N, geo::detail::polygon_tag>& shape, color_type color, byte alpha = 255, fill_rule rule = fill_rule::non_zero)
     {
-        std::map<int, geo::interval<int>> map;
-        for (const auto& segment : geo::get_segments(shape))
-        {
-            bresenham_line(
-                segment[0],
-                segment[1],
-                [&](const geo::vector_2d<int>& pos)
-                {
-                    auto& interval = map[pos.y()];
-                    interval = geo::make_union(interval, geo::interval<int>{ pos.x(), pos.x() + 1 });
-                });
-        }
+        const auto pattern = make_pattern(color);
 
-        for (const auto&[y, x] : map)
+        _rasterizer(shape, rule, image_region(), [&](int y, int x0, int x1)
         {
-            draw_scanline(y, x.min(), x.max(), color, alpha);
-        }
+            draw_span(y - _origin.y(), x0 - _origin.x(), x1 - _origin.x(), color, alpha, pattern);
+        });
         return *this;
     }
 
     drawing_context& draw(const std::string& text, const point& location, color_type color, byte alpha = 255)
     {
-        auto x = location.x();
-        auto y = location.y();
+        draw_label(text, location, color, alpha, make_pattern(color));
+        return *this;
+    }
 
-        for (auto ch : text)
+    /* Draws the labels in order, sharing the color setup between them. */
+    drawing_context& draw_text(const std::vector<text_label>& labels, color_type color, byte alpha = 255)
+    {
+        const auto pattern = make_pattern(color);
+
+        for (const auto& label : labels)
         {
-            if (ch == '\n')
-            {
-                x = location.x();
-                y += 8;
-            }
-            else
-            {
-                draw_char(ch, { x, y }, color, alpha);
-                x += 8;
-            }
+            draw_label(label.text, label.location, color, alpha, pattern);
         }
 
         return *this;
@@ -157,20 +237,77 @@ public:
     template <class T>
     drawing_context& draw_dot(const geo::vector_2d<T>& location, color_type color, byte alpha = 255)
     {
-        point loc = location;
+        const point loc = location;
+        const auto pattern = make_pattern(color);
 
         for (int y = -1; y <= +1; ++y)
         {
-            for (int x = -1; x <= +1; ++x)
-            {
-                draw_pixel(loc + point { x, y }, color, alpha);
-            }
+            draw_scanline(loc.y() + y, loc.x() - 1, loc.x() + 1, color, alpha, pattern);
         }
 
         return *this;
     }
 
 private:
+    enum class clipping
+    {
+        inside,
+        partial,
+        outside
+    };
+
+    /* the image in drawing coordinates */
+    image_region_t image_region() const
+    {
+        return { _origin, _origin + location_type{ _image.width(), _image.height() } };
+    }
+
+    bool contains(const point& point) const
+    {
+        return unsigned(point.x() - _origin.x()) < unsigned(_image.width())
+            && unsigned(point.y() - _origin.y()) < unsigned(_image.height());
+    }
+
+    /* decides once per primitive whether its pixels need to be clipped */
+    clipping get_clipping(const image_region_t& bounds) const
+    {
+        const auto image = image_region();
+        const auto part = detail::intersect(bounds, image);
+
+        return detail::is_empty(part) ? clipping::outside
+            : part.lower() == bounds.lower() && part.upper() == bounds.upper() ? clipping::inside
+            : clipping::partial;
+    }
+
+    void plot(clipping clip, const point& point, const color_type& color, byte alpha)
+    {
+        if (clip == clipping::inside || contains(point))
+        {
+            blend_pixel(point, color, alpha);
+        }
+    }
+
+    /* (color * alpha + dst * (255 - alpha) + 128) / 255 per channel; point must be inside the image */
+    void blend_pixel(const point& point, const color_type& color, byte alpha)
+    {
+        auto& dst = *_image.data(point - _origin);
+
+        if (alpha == 255)
+        {
+            dst = color;
+        }
+        else if (alpha != 0)
+        {
+            const auto* c = reinterpret_cast<const byte*>(&color);
+            auto* d = reinterpret_cast<byte*>(&dst);
+
+            for (size_t i = 0; i < sizeof(color_type); ++i)
+            {
+                d[i] = detail::blend_channel(c[i], d[i], alpha);
+            }
+        }
+    }
+
     template <class S>
     drawing_context& draw_segments(const S& shape, color_type color, byte alpha)
     {
@@ -182,164 +319,118 @@ private:
         return *this;
     }
 
-    void draw_scanline(int y, int x0, int x1, color_type color, byte alpha)
+    /* x0 and x1 are inclusive drawing coordinates */
+    void draw_scanline(int y, int x0, int x1, color_type color, byte alpha, const detail::span_pattern& pattern)
     {
-        for (auto x = x0; x <= x1; ++x)
+        y -= _origin.y();
+
+        if (y < 0 || y >= _image.height())
         {
-            draw_pixel({ x, y }, color, alpha);
+            return;
         }
+
+        x0 = std::max(x0 - _origin.x(), 0);
+        x1 = std::min(x1 - _origin.x() + 1, _image.width());
+
+        if (x0 < x1)
+        {
+            draw_span(y, x0, x1, color, alpha, pattern);
+        }
+    }
+
+    static detail::span_pattern make_pattern(const color_type& color)
+    {
+        return { reinterpret_cast<const byte*>(&color), sizeof(color_type) };
     }
 
+    /* [x0, x1) in image coordinates, already clipped */
+    void draw_span(int y, int x0, int x1, color_type color, byte alpha, const detail::span_pattern& pattern)
+    {
+        if (_image.stride()[0] != sizeof(color_type))
+        {
+            for (auto x = x0; x < x1; ++x)
+            {
+                blend_pixel(point{ x, y } + _origin, color, alpha);
+            }
+        }
+        else
+        {
+            blend_span(reinterpret_cast<byte*>(_image.data({ x0, y })), x1 - x0, alpha, pattern);
+        }
+    }
 
-    void draw_char(char ch, const point& location, color_type color, byte alpha)
+    void draw_label(const std::string& text, const point& location, color_type color, byte alpha, const detail::span_pattern& pattern)
     {
-        static const byte font8x8_basic[128][8] = {
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0000 (nul)
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0001
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0002
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0003
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0004
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0005
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0006
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0007
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0008
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0009
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000A
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000B
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000C
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000D
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000E
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000F
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0010
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0011
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0012
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0013
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0014
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0015
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0016
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0017
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0018
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0019
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001A
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001B
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001C
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001D
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001E
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001F
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0020 (space)
-            { 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00 },   // U+0021 (!)
-            { 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0022 (")
-            { 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00 },   // U+0023 (#)
-            { 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00 },   // U+0024 ($)
-            { 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00 },   // U+0025 (%)
-            { 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00 },   // U+0026 (&)
-            { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0027 (')
-            { 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00 },   // U+0028 (()
-            { 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00 },   // U+0029 ())
-            { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 },   // U+002A (*)
-            { 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00 },   // U+002B (+)
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06 },   // U+002C (,)
-            { 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00 },   // U+002D (-)
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 },   // U+002E (.)
-            { 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00 },   // U+002F (/)
-            { 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00 },   // U+0030 (0)
-            { 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00 },   // U+0031 (1)
-            { 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00 },   // U+0032 (2)
-            { 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00 },   // U+0033 (3)
-            { 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00 },   // U+0034 (4)
-            { 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00 },   // U+0035 (5)
-            { 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00 },   // U+0036 (6)
-            { 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00 },   // U+0037 (7)
-            { 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00 },   // U+0038 (8)
-            { 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00 },   // U+0039 (9)
-            { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00 },   // U+003A (:)
-            { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06 },   // U+003B (//)
-            { 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00 },   // U+003C (<)
-            { 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00 },   // U+003D (=)
-            { 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00 },   // U+003E (>)
-            { 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00 },   // U+003F (?)
-            { 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00 },   // U+0040 (@)
-            { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 },   // U+0041 (A)
-            { 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00 },   // U+0042 (B)
-            { 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00 },   // U+0043 (C)
-            { 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00 },   // U+0044 (D)
-            { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00 },   // U+0045 (E)
-            { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00 },   // U+0046 (F)
-            { 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00 },   // U+0047 (G)
-            { 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00 },   // U+0048 (H)
-            { 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0049 (I)
-            { 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00 },   // U+004A (J)
-            { 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00 },   // U+004B (K)
-            { 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00 },   // U+004C (L)
-            { 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00 },   // U+004D (M)
-            { 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00 },   // U+004E (N)
-            { 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00 },   // U+004F (O)
-            { 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00 },   // U+0050 (P)
-            { 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00 },   // U+0051 (Q)
-            { 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00 },   // U+0052 (R)
-            { 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00 },   // U+0053 (S)
-            { 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0054 (T)
-            { 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00 },   // U+0055 (U)
-            { 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },   // U+0056 (V)
-            { 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00 },   // U+0057 (W)
-            { 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00 },   // U+0058 (X)
-            { 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0059 (Y)
-            { 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00 },   // U+005A (Z)
-            { 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00 },   // U+005B ([)
-            { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00 },   // U+005C (\)
-            { 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00 },   // U+005D (])
-            { 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 },   // U+005E (^)
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF },   // U+005F (_)
-            { 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0060 (`)
-            { 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00 },   // U+0061 (a)
-            { 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00 },   // U+0062 (b)
-            { 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00 },   // U+0063 (c)
-            { 0x38, 0x30, 0x30, 0x3e, 0x33, 0x33, 0x6E, 0x00 },   // U+0064 (d)
-            { 0x00, 0x00, 0x1E, 0x33, 0x3f, 0x03, 0x1E, 0x00 },   // U+0065 (e)
-            { 0x1C, 0x36, 0x06, 0x0f, 0x06, 0x06, 0x0F, 0x00 },   // U+0066 (f)
-            { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F },   // U+0067 (g)
-            { 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00 },   // U+0068 (h)
-            { 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0069 (i)
-            { 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E },   // U+006A (j)
-            { 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00 },   // U+006B (k)
-            { 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+006C (l)
-            { 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00 },   // U+006D (m)
-            { 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00 },   // U+006E (n)
-            { 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00 },   // U+006F (o)
-            { 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F },   // U+0070 (p)
-            { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78 },   // U+0071 (q)
-            { 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00 },   // U+0072 (r)
-            { 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00 },   // U+0073 (s)
-            { 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00 },   // U+0074 (t)
-            { 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00 },   // U+0075 (u)
-            { 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },   // U+0076 (v)
-            { 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00 },   // U+0077 (w)
-            { 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00 },   // U+0078 (x)
-            { 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F },   // U+0079 (y)
-            { 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00 },   // U+007A (z)
-            { 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00 },   // U+007B ({)
-            { 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00 },   // U+007C (|)
-            { 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00 },   // U+007D (})
-            { 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+007E (~)
-            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }    // U+007F
-        };
-
-        auto letter = font8x8_basic[size_t(ch)];
-
-        for (int y = 0; y < 8; ++y)
+        if (alpha == 0 || get_clipping(detail::get_text_bounds(text, location)) == clipping::outside)
+        {
+            return;
+        }
+
+        auto x = location.x();
+        auto y = location.y();
+
+        for (auto ch : text)
+        {
+            if (ch == '\n')
+            {
+                x = location.x();
+                y += detail::glyph_cache::glyph_size;
+            }
+            else
+            {
+                draw_char(ch, { x, y }, color, alpha, pattern);
+                x += detail::glyph_cache::glyph_size;
+            }
+        }
+    }
+
+    /* count pixels of a contiguous row */
+    static void blend_span(byte* dst, int count, byte alpha, const detail::span_pattern& pattern)
+    {
+        if (alpha == 255)
+        {
+            detail::fill_span(pattern, dst, count * int(sizeof(color_type)));
+        }
+        else if (alpha != 0)
+        {
+            detail::blend_span(pattern, alpha, dst, count * int(sizeof(color_type)));
+        }
+    }
+
+    void draw_char(char ch, const point& location, color_type color, byte alpha, const detail::span_pattern& pattern)
+    {
+        const auto clip = get_clipping({ location, location + point{ detail::glyph_cache::glyph_size, detail::glyph_cache::glyph_size } });
+
+        if (clip == clipping::outside)
+        {
+            return;
+        }
+
+        const auto glyph = detail::glyph_cache::instance().get(ch);
+
+        if (clip == clipping::inside && _image.stride()[0] == sizeof(color_type))
+        {
+            /* the whole glyph is inside, so its rows are blitted without clipping */
+            auto* origin = reinterpret_cast<byte*>(_image.data(location - _origin));
+            const auto row_stride = _image.stride()[1];
+
+            for (auto run = glyph.begin; run != glyph.end; ++run)
+            {
+                blend_span(origin + run->y * row_stride + run->x_begin * int(sizeof(color_type)), run->x_end - run->x_begin, alpha, pattern);
+            }
+        }
+        else
         {
-            for (int x = 0; x < 8; ++x)
+            for (auto run = glyph.begin; run != glyph.end; ++run)
             {
-                if (letter[y] & 1 << x)
-                {
-                    draw_pixel(location + point({ x, y }), color, alpha);
-                }
+                draw_scanline(location.y() + run->y, location.x() + run->x_begin, location.x() + run->x_end - 1, color, alpha, pattern);
             }
         }
     }
 
     typename arrays::array<color_type, 2>::view_type _image;
-    typename arrays::array<color_type, 2>::bounds_type _bounds;
+    point _origin;
+    detail::polygon_rasterizer _rasterizer;
 };
 
 struct make_drawing_context_fn
@@ -0,0 +1,229 @@
+#ifndef CPP_ESSENTIALS_GX_EXECUTION_HPP_
+#define CPP_ESSENTIALS_GX_EXECUTION_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpp_essentials::gx
+{
+
+namespace execution
+{
+
+struct sequenced_policy
+{
+};
+
+struct parallel_policy
+{
+    size_t thread_count = 0;
+
+    parallel_policy operator ()(size_t count) const
+    {
+        return { count };
+    }
+};
+
+static constexpr auto seq = sequenced_policy{};
+static constexpr auto par = parallel_policy{};
+
+} /* namespace execution */
+
+namespace detail
+{
+
+class worker_pool
+{
+public:
+    explicit worker_pool(size_t thread_count)
+    {
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            _threads.emplace_back([this]() { work(); });
+        }
+    }
+
+    worker_pool(const worker_pool&) = delete;
+    worker_pool& operator =(const worker_pool&) = delete;
+
+    ~worker_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _stop = true;
+        }
+
+        _work_cv.notify_all();
+
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    size_t size() const
+    {
+        return _threads.size() + 1;
+    }
+
+    /* Runs func(0) .. func(count - 1) on the pool; the calling thread takes part and returns when all tasks are done. */
+    void run(size_t count, const std::function<void(size_t)>& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (count == 1 || _threads.empty())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+
+            return;
+        }
+
+        batch current{ &func, count, 0, 0, nullptr };
+
+        std::unique_lock<std::mutex> lock{ _mutex };
+
+        _queue.push_back(&current);
+        _work_cv.notify_all();
+
+        while (current.done < current.count)
+        {
+            if (!_queue.empty())
+            {
+                execute(lock);
+            }
+            else
+            {
+                _done_cv.wait(lock);
+            }
+        }
+
+        if (current.error)
+        {
+            std::rethrow_exception(current.error);
+        }
+    }
+
+    static worker_pool& instance()
+    {
+        static worker_pool pool{ std::max(std::thread::hardware_concurrency(), 1U) - 1 };
+        return pool;
+    }
+
+private:
+    struct batch
+    {
+        const std::function<void(size_t)>* func;
+        size_t count;
+        size_t next = 0;
+        size_t done = 0;
+        std::exception_ptr error;
+    };
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+
+        while (true)
+        {
+            _work_cv.wait(lock, [this]() { return _stop || !_queue.empty(); });
+
+            if (_queue.empty())
+            {
+                return;
+            }
+
+            execute(lock);
+        }
+    }
+
+    void execute(std::unique_lock<std::mutex>& lock)
+    {
+        auto* current = _queue.front();
+        const auto index = current->next++;
+
+        if (current->next == current->count)
+        {
+            _queue.pop_front();
+        }
+
+        lock.unlock();
+
+        std::exception_ptr error;
+
+        try
+        {
+            (*current->func)(index);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+
+        if (error && !current->error)
+        {
+            current->error = error;
+        }
+
+        if (++current->done == current->count)
+        {
+            _done_cv.notify_all();
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::deque<batch*> _queue;
+    std::mutex _mutex;
+    std::condition_variable _work_cv;
+    std::condition_variable _done_cv;
+    bool _stop = false;
+};
+
+inline size_t get_task_count(const execution::parallel_policy& policy)
+{
+    return policy.thread_count > 0
+        ? policy.thread_count
+        : worker_pool::instance().size();
+}
+
+/* Splits [0, count) into contiguous bands and calls func(begin, end) for each of them on the worker pool. */
+template <class Func>
+void parallel_for_bands(const execution::parallel_policy& policy, int count, int min_band_size, Func&& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    const auto max_bands = std::max(1, count / std::max(min_band_size, 1));
+    const auto band_count = std::min(max_bands, static_cast<int>(get_task_count(policy)));
+
+    worker_pool::instance().run(band_count, [&](size_t index)
+    {
+        const auto begin = static_cast<int>(count * static_cast<long long>(index) / band_count);
+        const auto end = static_cast<int>(count * static_cast<long long>(index + 1) / band_count);
+
+        func(begin, end);
+    });
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_EXECUTION_HPP_ */
@@ -136,7 +136,7 @@ struct lighter : uniform_color_filter<lighter>
 {
     int apply(int lhs, int rhs) const
     {
-        return core::min(lhs, rhs);
+        return core::max(lhs, rhs);
     }
 };
 
@@ -0,0 +1,65 @@
+#ifndef CPP_ESSENTIALS_GX_GRADIENT_HPP_
+#define CPP_ESSENTIALS_GX_GRADIENT_HPP_
+
+#pragma once
+
+#include <cstdint>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/kernels.hpp>
+#include <cpp_essentials/gx/detail/gradient.hpp>
+
+namespace cpp_essentials::gx
+{
+
+namespace detail
+{
+
+template <class T>
+void gradient(
+    byte_image::const_view_type source,
+    typename image<T>::view_type magnitude,
+    byte_image::view_type* direction,
+    const kernel_convolution_t<2>& kernels,
+    gradient_norm norm)
+{
+    EXPECTS(kernels._kernels[0].size() == kernels._kernels[1].size(), "gradient kernels must have equal sizes");
+
+    if (can_fuse_gradient(kernels._fixed_point[0], kernels._fixed_point[1]))
+    {
+        fused_gradient<T>(source, magnitude, direction, *kernels._fixed_point[0], *kernels._fixed_point[1], norm);
+    }
+    else
+    {
+        region_gradient<T>(source, magnitude, direction, kernels._kernels[0], kernels._kernels[1], norm);
+    }
+}
+
+} /* namespace detail */
+
+/* Magnitude of a gradient pair such as kernels::sobel(); outputs are anchored at the top-left corner of each neighborhood, like convolve(). */
+inline void gradient(byte_image::const_view_type source, byte_image::view_type magnitude, const kernel_convolution_t<2>& kernels, gradient_norm norm = gradient_norm::l2)
+{
+    detail::gradient<byte>(source, magnitude, nullptr, kernels, norm);
+}
+
+/* As above, with the gradient direction quantized to 4 sectors: 0 - horizontal, 1 - 45 degrees, 2 - vertical, 3 - 135 degrees. */
+inline void gradient(byte_image::const_view_type source, byte_image::view_type magnitude, byte_image::view_type direction, const kernel_convolution_t<2>& kernels, gradient_norm norm = gradient_norm::l2)
+{
+    detail::gradient<byte>(source, magnitude, &direction, kernels, norm);
+}
+
+/* Unsaturated magnitude, e.g. for gradient_norm::squared. */
+inline void gradient(byte_image::const_view_type source, image<std::int32_t>::view_type magnitude, const kernel_convolution_t<2>& kernels, gradient_norm norm = gradient_norm::l2)
+{
+    detail::gradient<std::int32_t>(source, magnitude, nullptr, kernels, norm);
+}
+
+inline void gradient(byte_image::const_view_type source, image<std::int32_t>::view_type magnitude, byte_image::view_type direction, const kernel_convolution_t<2>& kernels, gradient_norm norm = gradient_norm::l2)
+{
+    detail::gradient<std::int32_t>(source, magnitude, &direction, kernels, norm);
+}
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_GRADIENT_HPP_ */
@@ -3,7 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/detail/histogram_counter.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
 #include <cpp_essentials/gx/lookup_table.hpp>
 #include <cpp_essentials/sq/sq.hpp>
 #include <cpp_essentials/core/container_helpers.hpp>
@@ -11,24 +18,72 @@
 namespace cpp_essentials::gx
 {
 
+template <class T>
+class tiled_image;
+
 namespace detail
 {
 
-using histogram_t = std::array<size_t, 256>;
+using rgb_histogram_t = std::array<histogram_t, 3>;
 
 inline histogram_t make_histogram(byte_image::const_view_type image)
 {
-    histogram_t result;
-    core::fill(result, 0);
+    histogram_counter<1> counter;
+    counter.add(image);
+    return counter.result()[0];
+}
+
+/* All three channel histograms in one pass over the pixels. */
+inline rgb_histogram_t make_histogram(rgb_image::const_view_type image)
+{
+    histogram_counter<3> counter;
+    counter.add(image);
+    return counter.result();
+}
 
-    for (const auto& v : image)
+template <size_t Channels, class View>
+std::array<histogram_t, Channels> make_histograms(const execution::parallel_policy& policy, const View& image)
+{
+    std::array<histogram_t, Channels> result;
+
+    for (auto& histogram : result)
     {
-        ++result[v];
+        histogram.fill(0);
     }
 
+    std::mutex mutex;
+
+    parallel_for_bands(policy, image.height(), 64, [&](int begin, int end)
+    {
+        histogram_counter<Channels> counter;
+        counter.add(image.region({ { 0, begin }, { image.width(), end } }));
+
+        const auto& partial = counter.result();
+
+        std::lock_guard<std::mutex> lock{ mutex };
+
+        for (size_t c = 0; c < Channels; ++c)
+        {
+            for (size_t i = 0; i < result[c].size(); ++i)
+            {
+                result[c][i] += partial[c][i];
+            }
+        }
+    });
+
     return result;
 }
 
+inline histogram_t make_histogram(const execution::parallel_policy& policy, byte_image::const_view_type image)
+{
+    return make_histograms<1>(policy, image)[0];
+}
+
+inline rgb_histogram_t make_histogram(const execution::parallel_policy& policy, rgb_image::const_view_type image)
+{
+    return make_histograms<3>(policy, image);
+}
+
 inline histogram_t accumulate_histogram(const histogram_t& histogram)
 {
     histogram_t result;
@@ -142,7 +197,7 @@ struct histogram_operation_fn
     void operator ()(byte_image::const_view_type source, byte_image::view_type dest) const
     {
         static const auto op = Op{};
-        core::transform(source, dest.begin(), op(make_histogram(source)));
+        apply(op(make_histogram(source)), source, dest);
     }
 
     void operator ()(byte_image::view_type image) const
@@ -152,16 +207,295 @@ struct histogram_operation_fn
 
     void operator ()(rgb_image::const_view_type source, rgb_image::view_type dest) const
     {
-        for (size_t i = 0; i < 3; ++i)
-        {
-            (*this)(gx::channel(source, i), gx::channel(dest, i));
-        }
+        apply(make_luts(make_histogram(source)), source, dest);
     }
 
     void operator ()(rgb_image::view_type image) const
     {
         (*this)(image, image);
     }
+
+    void operator ()(const execution::parallel_policy& policy, byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        static const auto op = Op{};
+        const auto lut = op(make_histogram(policy, source));
+
+        parallel_for_bands(policy, source.height(), 64, [&](int begin, int end)
+        {
+            apply(
+                lut,
+                source.region({ { 0, begin }, { source.width(), end } }),
+                dest.region({ { 0, begin }, { dest.width(), end } }));
+        });
+    }
+
+    void operator ()(const execution::parallel_policy& policy, byte_image::view_type image) const
+    {
+        (*this)(policy, image, image);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgb_image::const_view_type source, rgb_image::view_type dest) const
+    {
+        const auto luts = make_luts(make_histogram(policy, source));
+
+        parallel_for_bands(policy, source.height(), 64, [&](int begin, int end)
+        {
+            apply(
+                luts,
+                source.region({ { 0, begin }, { source.width(), end } }),
+                dest.region({ { 0, begin }, { dest.width(), end } }));
+        });
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgb_image::view_type image) const
+    {
+        (*this)(policy, image, image);
+    }
+
+    /* defined for byte and rgb tiles in tiled_operations.hpp */
+    template <class T>
+    void operator ()(const tiled_image<T>& source, tiled_image<T>& dest) const
+    {
+        static const auto op = Op{};
+        apply_histogram_operation(op, source, dest);
+    }
+
+private:
+    static std::array<lookup_table, 3> make_luts(const rgb_histogram_t& histograms)
+    {
+        static const auto op = Op{};
+        return { op(histograms[0]), op(histograms[1]), op(histograms[2]) };
+    }
+};
+
+/* Clips the histogram at limit and spreads the excess evenly over all bins, the remainder one count per bin from the darkest. */
+inline void clip_histogram(histogram_t& histogram, size_t limit)
+{
+    size_t excess = 0;
+
+    for (auto& count : histogram)
+    {
+        if (count > limit)
+        {
+            excess += count - limit;
+            count = limit;
+        }
+    }
+
+    const auto share = excess / histogram.size();
+    const auto remainder = excess % histogram.size();
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+        histogram[i] += share + (i < remainder ? 1 : 0);
+    }
+}
+
+/* Contrast-limited adaptive histogram equalization. Each tile of a grid gets the equalizing table of its clipped histogram;
+   a pixel is mapped by the tables of the four nearest tile centers, bilinearly weighted. */
+class adaptive_equalization
+{
+public:
+    adaptive_equalization(const size_type& size, const size_type& tiles, float clip_limit)
+        : _tiles(tiles)
+        , _clip_limit(clip_limit)
+        , _luts(size_t(tiles.x()) * size_t(tiles.y()))
+        , _columns(make_axis(size.x(), tiles.x()))
+        , _rows(make_axis(size.y(), tiles.y()))
+    {
+        EXPECTS(tiles.x() > 0 && tiles.y() > 0 && tiles.x() <= size.x() && tiles.y() <= size.y(), "adaptive_equalize: invalid tile grid");
+        EXPECTS(clip_limit > 0.F, "adaptive_equalize: non-positive clip limit");
+    }
+
+    int tile_count() const
+    {
+        return int(_luts.size());
+    }
+
+    void build_tile(byte_image::const_view_type source, int index)
+    {
+        const auto x = index % _tiles.x();
+        const auto y = index / _tiles.x();
+
+        const image_region_t region{
+            location_type{ _columns.bounds[x], _rows.bounds[y] },
+            location_type{ _columns.bounds[x + 1], _rows.bounds[y + 1] } };
+
+        const auto area = size_t(region.size().x()) * size_t(region.size().y());
+
+        auto histogram = make_histogram(source.region(region));
+        clip_histogram(histogram, std::max(size_t(_clip_limit * area / histogram.size()), size_t(1)));
+
+        const auto cum_hist = accumulate_histogram(histogram);
+        const auto total = cum_hist.back();
+
+        _luts[index] = make_lut([&](int v) { return int((255 * cum_hist[v] + total / 2) / total); }).table();
+    }
+
+    void map_rows(byte_image::const_view_type source, byte_image::view_type dest, int begin, int end) const
+    {
+        source_rows input{ source, 1 };
+        dest_row output{ dest, dest.width() };
+
+        for (auto y = begin; y < end; ++y)
+        {
+            const auto& row = _rows.samples[y];
+            const auto wy = row.weight;
+
+            const auto* src = input[y];
+            auto* dst = output.get(y);
+
+            for (const auto& segment : _columns.segments)
+            {
+                const auto& top_left = _luts[row.first * _tiles.x() + segment.first];
+                const auto& top_right = _luts[row.first * _tiles.x() + segment.second];
+                const auto& bottom_left = _luts[row.second * _tiles.x() + segment.first];
+                const auto& bottom_right = _luts[row.second * _tiles.x() + segment.second];
+
+                for (auto x = segment.begin; x < segment.end; ++x)
+                {
+                    const auto v = src[x];
+                    const auto wx = _columns.samples[x].weight;
+
+                    const auto top = top_left[v] * (256 - wx) + top_right[v] * wx;
+                    const auto bottom = bottom_left[v] * (256 - wx) + bottom_right[v] * wx;
+
+                    dst[x] = byte((top * (256 - wy) + bottom * wy + 32768) >> 16);
+                }
+            }
+
+            output.commit(y);
+        }
+    }
+
+private:
+    /* the two tiles whose centers enclose a pixel, and the weight of the second one in 1/256 */
+    struct sample
+    {
+        int first;
+        int second;
+        int weight;
+    };
+
+    /* a run of pixels sharing the same pair of tiles */
+    struct segment
+    {
+        int begin;
+        int end;
+        int first;
+        int second;
+    };
+
+    struct axis
+    {
+        std::vector<int> bounds;
+        std::vector<sample> samples;
+        std::vector<segment> segments;
+    };
+
+    static axis make_axis(int size, int tiles)
+    {
+        axis result;
+
+        for (int i = 0; i <= tiles; ++i)
+        {
+            result.bounds.push_back(int(size * static_cast<long long>(i) / tiles));
+        }
+
+        std::vector<double> centers;
+
+        for (int i = 0; i < tiles; ++i)
+        {
+            centers.push_back(0.5 * (result.bounds[i] + result.bounds[i + 1]));
+        }
+
+        int first = 0;
+
+        for (int p = 0; p < size; ++p)
+        {
+            const auto t = p + 0.5;
+
+            while (first + 1 < tiles && centers[first + 1] <= t)
+            {
+                ++first;
+            }
+
+            sample s{ first, first, 0 };
+
+            if (t > centers[first] && first + 1 < tiles)
+            {
+                s.second = first + 1;
+                s.weight = int(256.0 * (t - centers[first]) / (centers[first + 1] - centers[first]) + 0.5);
+            }
+
+            if (result.segments.empty() || result.segments.back().first != s.first || result.segments.back().second != s.second)
+            {
+                result.segments.push_back({ p, p + 1, s.first, s.second });
+            }
+            else
+            {
+                result.segments.back().end = p + 1;
+            }
+
+            result.samples.push_back(s);
+        }
+
+        return result;
+    }
+
+    size_type _tiles;
+    float _clip_limit;
+    std::vector<lookup_table::table_type> _luts;
+    axis _columns;
+    axis _rows;
+};
+
+struct adaptive_equalize_fn
+{
+    void operator ()(byte_image::const_view_type source, byte_image::view_type dest, const size_type& tiles = { 8, 8 }, float clip_limit = 2.F) const
+    {
+        EXPECTS(source.size() == dest.size(), "adaptive_equalize: size mismatch");
+
+        adaptive_equalization equalization{ source.size(), tiles, clip_limit };
+
+        for (int i = 0; i < equalization.tile_count(); ++i)
+        {
+            equalization.build_tile(source, i);
+        }
+
+        equalization.map_rows(source, dest, 0, source.height());
+    }
+
+    void operator ()(byte_image::view_type image, const size_type& tiles = { 8, 8 }, float clip_limit = 2.F) const
+    {
+        (*this)(image, image, tiles, clip_limit);
+    }
+
+    /* Tiles build their tables concurrently, then bands of rows are mapped concurrently. */
+    void operator ()(const execution::parallel_policy& policy, byte_image::const_view_type source, byte_image::view_type dest, const size_type& tiles = { 8, 8 }, float clip_limit = 2.F) const
+    {
+        EXPECTS(source.size() == dest.size(), "adaptive_equalize: size mismatch");
+
+        adaptive_equalization equalization{ source.size(), tiles, clip_limit };
+
+        parallel_for_bands(policy, equalization.tile_count(), 1, [&](int begin, int end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                equalization.build_tile(source, i);
+            }
+        });
+
+        parallel_for_bands(policy, source.height(), 64, [&](int begin, int end)
+        {
+            equalization.map_rows(source, dest, begin, end);
+        });
+    }
+
+    void operator ()(const execution::parallel_policy& policy, byte_image::view_type image, const size_type& tiles = { 8, 8 }, float clip_limit = 2.F) const
+    {
+        (*this)(policy, image, image, tiles, clip_limit);
+    }
 };
 
 } /* namespace detail */
@@ -170,6 +504,9 @@ static constexpr auto equalize = detail::histogram_operation_fn<detail::equalize
 static constexpr auto stretch = detail::histogram_operation_fn<detail::stretch_fn>{};
 static constexpr auto otsu = detail::histogram_operation_fn<detail::otsu_fn>{};
 
+/* tiles is the size of the tile grid; clip_limit is the highest histogram bin relative to a uniform distribution */
+static constexpr auto adaptive_equalize = detail::adaptive_equalize_fn{};
+
 } /* namespace cpp_essentials::gx */
 
 #endif /* CPP_ESSENTIALS_GX_HISTOGRAM_OPERATIONS_HPP_ */
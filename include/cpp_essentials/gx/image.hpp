@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <cpp_essentials/arrays/array.hpp>
 #include <cpp_essentials/gx/color_models.hpp>
 
@@ -33,12 +35,19 @@ struct bytes_per_pixel<rgba_color>
     static constexpr size_t value = 4;
 };
 
+template <>
+struct bytes_per_pixel<bgr_color>
+{
+    static constexpr size_t value = 3;
+};
+
 template <class T>
 using image = arrays::array<T, 2, bytes_per_pixel<T>::value>;
 
 using byte_image = image<byte>;
 using rgb_image = image<rgb_color>;
 using rgba_image = image<rgba_color>;
+using bgr_image = image<bgr_color>;
 
 using kernel_type = arrays::array<float, 2>;
 
@@ -65,6 +74,27 @@ using image_region_t = arrays::array_region_t<2>;
 namespace detail
 {
 
+inline image_region_t intersect(const image_region_t& lhs, const image_region_t& rhs)
+{
+    const location_type lower{ std::max(lhs.lower().x(), rhs.lower().x()), std::max(lhs.lower().y(), rhs.lower().y()) };
+    const location_type upper{ std::min(lhs.upper().x(), rhs.upper().x()), std::min(lhs.upper().y(), rhs.upper().y()) };
+
+    return { lower, location_type{ std::max(lower.x(), upper.x()), std::max(lower.y(), upper.y()) } };
+}
+
+inline bool is_empty(const image_region_t& region)
+{
+    return region.upper().x() <= region.lower().x() || region.upper().y() <= region.lower().y();
+}
+
+/* half-open bounds of the segment between a and b, grown by margin on every side */
+inline image_region_t get_bounds(const location_type& a, const location_type& b, int margin)
+{
+    return {
+        location_type{ std::min(a.x(), b.x()) - margin, std::min(a.y(), b.y()) - margin },
+        location_type{ std::max(a.x(), b.x()) + margin + 1, std::max(a.y(), b.y()) + margin + 1 } };
+}
+
 template <class ImageView>
 byte_image::view_type channel(ImageView&& img, size_t index, std::false_type)
 {
@@ -0,0 +1,219 @@
+#ifndef CPP_ESSENTIALS_GX_INTEGRAL_IMAGE_HPP_
+#define CPP_ESSENTIALS_GX_INTEGRAL_IMAGE_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cpp_essentials/core/assertions.hpp>
+#include <cpp_essentials/geo/contains.hpp>
+#include <cpp_essentials/gx/image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+/* Summed-area table: entry (x, y) holds the sum of all source values above and to the left of (x, y), so the sum over any region takes four lookups. */
+class integral_image
+{
+public:
+    using value_type = double;
+
+    integral_image() = default;
+
+    explicit integral_image(byte_image::const_view_type source)
+    {
+        build(source, nullptr);
+    }
+
+    explicit integral_image(kernel_type::const_view_type source)
+    {
+        build(source, nullptr);
+    }
+
+    size_type size() const
+    {
+        return _size;
+    }
+
+    image_bounds_t bounds() const
+    {
+        return { geo::zeros, _size };
+    }
+
+    value_type sum(const image_region_t& region) const
+    {
+        return lookup(_sum, region);
+    }
+
+    value_type mean(const image_region_t& region) const
+    {
+        const auto area = value_type(region.size().x()) * region.size().y();
+
+        return area > 0 ? sum(region) / area : value_type{};
+    }
+
+    /* Row y of the table, size().x() + 1 entries; row 0 is all zeros. */
+    const value_type* row(int y) const
+    {
+        return _sum.data() + offset(0, y);
+    }
+
+protected:
+    template <class View>
+    void build(View source, std::vector<value_type>* squared_sum)
+    {
+        _size = source.size();
+
+        _sum.assign(offset(0, _size.y() + 1), value_type{});
+
+        if (squared_sum)
+        {
+            squared_sum->assign(_sum.size(), value_type{});
+        }
+
+        for (int y = 0; y < _size.y(); ++y)
+        {
+            const auto* prev = _sum.data() + offset(0, y);
+            auto* next = _sum.data() + offset(0, y + 1);
+
+            value_type row_sum = 0;
+            value_type row_squared_sum = 0;
+
+            for (int x = 0; x < _size.x(); ++x)
+            {
+                const value_type value = source[{ x, y }];
+
+                row_sum += value;
+                next[x + 1] = prev[x + 1] + row_sum;
+
+                if (squared_sum)
+                {
+                    row_squared_sum += value * value;
+                    (*squared_sum)[offset(x + 1, y + 1)] = (*squared_sum)[offset(x + 1, y)] + row_squared_sum;
+                }
+            }
+        }
+    }
+
+    value_type lookup(const std::vector<value_type>& table, const image_region_t& region) const
+    {
+        EXPECTS(geo::contains(bounds(), region), "region out of bounds");
+
+        const auto lower = region.lower();
+        const auto upper = region.upper();
+
+        return table[offset(upper.x(), upper.y())]
+            - table[offset(upper.x(), lower.y())]
+            - table[offset(lower.x(), upper.y())]
+            + table[offset(lower.x(), lower.y())];
+    }
+
+    /* index of entry (x, y); tables may have more than 2^31 entries */
+    size_t offset(int x, int y) const
+    {
+        return size_t(y) * (size_t(_size.x()) + 1) + size_t(x);
+    }
+
+    size_type _size;
+    std::vector<value_type> _sum;
+};
+
+/* Integral image that also keeps the sums of squared values, which gives the variance of any region in eight lookups. */
+class squared_integral_image : public integral_image
+{
+public:
+    squared_integral_image() = default;
+
+    explicit squared_integral_image(byte_image::const_view_type source)
+    {
+        build(source, &_squared_sum);
+    }
+
+    explicit squared_integral_image(kernel_type::const_view_type source)
+    {
+        build(source, &_squared_sum);
+    }
+
+    value_type squared_sum(const image_region_t& region) const
+    {
+        return lookup(_squared_sum, region);
+    }
+
+    value_type variance(const image_region_t& region) const
+    {
+        const auto area = value_type(region.size().x()) * region.size().y();
+
+        if (area <= 0)
+        {
+            return value_type{};
+        }
+
+        const auto mean = sum(region) / area;
+
+        return std::max(squared_sum(region) / area - mean * mean, value_type{});
+    }
+
+    value_type standard_deviation(const image_region_t& region) const
+    {
+        return std::sqrt(variance(region));
+    }
+
+private:
+    std::vector<value_type> _squared_sum;
+};
+
+namespace detail
+{
+
+inline image_region_t get_window(const location_type& center, const size_type& window_size, const size_type& bounds)
+{
+    const location_type lower = center - window_size / 2;
+    const location_type upper = lower + window_size;
+
+    return
+    {
+        location_type{ std::max(lower.x(), 0), std::max(lower.y(), 0) },
+        location_type{ std::min(upper.x(), bounds.x()), std::min(upper.y(), bounds.y()) }
+    };
+}
+
+} /* namespace detail */
+
+/* Sets pixels brighter than the mean of their window minus offset to 255 and the rest to 0; windows are clipped at the image borders. */
+inline void adaptive_threshold(byte_image::const_view_type source, byte_image::view_type dest, const size_type& window_size, int offset = 0)
+{
+    const integral_image integral{ source };
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        for (int x = 0; x < source.width(); ++x)
+        {
+            const auto mean = integral.mean(detail::get_window({ x, y }, window_size, source.size()));
+
+            dest[{ x, y }] = source[{ x, y }] > mean - offset ? 255 : 0;
+        }
+    }
+}
+
+/* Maps every pixel to target_mean + target_deviation * (value - local mean) / local standard deviation. */
+inline void local_normalize(byte_image::const_view_type source, byte_image::view_type dest, const size_type& window_size, float target_mean = 128.F, float target_deviation = 64.F)
+{
+    const squared_integral_image integral{ source };
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        for (int x = 0; x < source.width(); ++x)
+        {
+            const auto window = detail::get_window({ x, y }, window_size, source.size());
+            const auto deviation = std::max(integral.standard_deviation(window), 1.0);
+
+            dest[{ x, y }] = to_byte(target_mean + target_deviation * (source[{ x, y }] - integral.mean(window)) / deviation + 0.5);
+        }
+    }
+}
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_INTEGRAL_IMAGE_HPP_ */
@@ -28,7 +28,7 @@ namespace detail
 
 inline kernel_type normalized(const kernel_type& img)
 {
-    auto sum = sq::accumulate(img, 0.F);
+    auto sum = core::accumulate(img, 0.F);
 
     kernel_type result { img.size() };
 
@@ -180,6 +180,13 @@ inline auto box_blur(size_type size) -> kernel_convolution_t<1>
     return { { detail::normalized(result) } };
 }
 
+
+
+inline auto separable(std::vector<float> row, std::vector<float> column) -> kernel_convolution_t<1>
+{
+    return { separable_kernel_t{ std::move(row), std::move(column) } };
+}
+
 #if 0
 inline auto gaussian_blur(size_type size, float sigma) -> kernel_convolution_t<1>
 {
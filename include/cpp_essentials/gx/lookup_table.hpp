@@ -3,11 +3,13 @@
 
 #pragma once
 
-#include <functional>
+#include <array>
 #include <vector>
 
 #include <cpp_essentials/core/functors.hpp>
 #include <cpp_essentials/gx/colors.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/lut_apply.hpp>
 
 namespace cpp_essentials::gx
 {
@@ -15,10 +17,17 @@ namespace cpp_essentials::gx
 class lookup_table
 {
 public:
-    lookup_table(std::vector<byte> lut)
-        : _lut(std::move(lut))
+    using table_type = std::array<byte, 256>;
+
+    lookup_table(const table_type& lut)
+        : _lut(lut)
     {
-        EXPECTS(_lut.size() == 256);
+    }
+
+    lookup_table(const std::vector<byte>& lut)
+    {
+        EXPECTS(lut.size() == 256);
+        core::copy(lut, _lut.begin());
     }
 
     byte operator ()(byte value) const
@@ -51,14 +60,20 @@ public:
         return result;
     }
 
+    const table_type& table() const
+    {
+        return _lut;
+    }
+
 private:
-    std::vector<byte> _lut;
+    table_type _lut;
 };
 
 
-inline lookup_table make_lut(std::function<int(int)> func)
+template <class Func>
+lookup_table make_lut(Func&& func)
 {
-    std::vector<byte> result(256);
+    lookup_table::table_type result;
 
     for (size_t i = 0; i < result.size(); ++i)
     {
@@ -69,6 +84,143 @@ inline lookup_table make_lut(std::function<int(int)> func)
 }
 
 
+namespace detail
+{
+
+template <class SourceView, class DestView, class RowFn>
+void apply_rows(const SourceView& source, const DestView& dest, RowFn row_fn)
+{
+    EXPECTS(source.size() == dest.size(), "apply: size mismatch");
+
+    const auto contiguous = is_contiguous_row(source) && is_contiguous_row(dest);
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        const auto* src = reinterpret_cast<const byte*>(source.data({ 0, y }));
+        auto* dst = reinterpret_cast<byte*>(dest.data({ 0, y }));
+
+        row_fn(src, dst, contiguous);
+    }
+}
+
+} /* namespace detail */
+
+inline void apply(const lookup_table& lut, byte_image::const_view_type source, byte_image::view_type dest)
+{
+    detail::apply_rows(source, dest, [&](const byte* src, byte* dst, bool contiguous)
+    {
+        if (contiguous)
+        {
+            detail::lut_row(lut.table().data(), src, dst, source.width());
+            return;
+        }
+
+        const auto src_step = source.stride()[0];
+        const auto dst_step = dest.stride()[0];
+
+        for (int x = 0; x < source.width(); ++x, src += src_step, dst += dst_step)
+        {
+            *dst = lut(*src);
+        }
+    });
+}
+
+inline void apply(const lookup_table& lut, rgb_image::const_view_type source, rgb_image::view_type dest)
+{
+    detail::apply_rows(source, dest, [&](const byte* src, byte* dst, bool contiguous)
+    {
+        if (contiguous)
+        {
+            detail::lut_row(lut.table().data(), src, dst, 3 * source.width());
+            return;
+        }
+
+        const auto src_step = source.stride()[0];
+        const auto dst_step = dest.stride()[0];
+
+        for (int x = 0; x < source.width(); ++x, src += src_step, dst += dst_step)
+        {
+            dst[0] = lut(src[0]);
+            dst[1] = lut(src[1]);
+            dst[2] = lut(src[2]);
+        }
+    });
+}
+
+/* Alpha is left unchanged. */
+inline void apply(const lookup_table& lut, rgba_image::const_view_type source, rgba_image::view_type dest)
+{
+    detail::apply_rows(source, dest, [&](const byte* src, byte* dst, bool contiguous)
+    {
+        if (contiguous)
+        {
+            detail::rgba_lut_row(lut.table().data(), src, dst, 4 * source.width());
+            return;
+        }
+
+        const auto src_step = source.stride()[0];
+        const auto dst_step = dest.stride()[0];
+
+        for (int x = 0; x < source.width(); ++x, src += src_step, dst += dst_step)
+        {
+            dst[0] = lut(src[0]);
+            dst[1] = lut(src[1]);
+            dst[2] = lut(src[2]);
+            dst[3] = src[3];
+        }
+    });
+}
+
+/* Separate tables for the red, green and blue channels. */
+inline void apply(const std::array<lookup_table, 3>& luts, rgb_image::const_view_type source, rgb_image::view_type dest)
+{
+    detail::apply_rows(source, dest, [&](const byte* src, byte* dst, bool)
+    {
+        const auto src_step = source.stride()[0];
+        const auto dst_step = dest.stride()[0];
+
+        for (int x = 0; x < source.width(); ++x, src += src_step, dst += dst_step)
+        {
+            dst[0] = luts[0](src[0]);
+            dst[1] = luts[1](src[1]);
+            dst[2] = luts[2](src[2]);
+        }
+    });
+}
+
+/* Colormap from byte values to colors, e.g. heatmap::values. */
+inline void apply(const std::array<rgb_color, 256>& palette, byte_image::const_view_type source, rgb_image::view_type dest)
+{
+    EXPECTS(source.size() == dest.size(), "apply: size mismatch");
+
+    const detail::palette_rows palette_row{ palette };
+    const auto contiguous = detail::is_contiguous_row(source) && detail::is_contiguous_row(dest);
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        const auto* src = source.data({ 0, y });
+        auto* dst = reinterpret_cast<byte*>(dest.data({ 0, y }));
+
+        if (contiguous)
+        {
+            palette_row(src, dst, source.width());
+            continue;
+        }
+
+        const auto src_step = source.stride()[0];
+        const auto dst_step = dest.stride()[0];
+
+        for (int x = 0; x < source.width(); ++x, src += src_step, dst += dst_step)
+        {
+            const auto& color = palette[*src];
+
+            dst[0] = color[0];
+            dst[1] = color[1];
+            dst[2] = color[2];
+        }
+    }
+}
+
 inline lookup_table operator *(const lookup_table& lhs, const lookup_table& rhs)
 {
     return make_lut([&](int v) { return rhs(lhs(static_cast<byte>(v))); });
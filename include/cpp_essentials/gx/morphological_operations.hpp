@@ -4,6 +4,8 @@
 #pragma once
 
 #include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/planar_image.hpp>
 #include <cpp_essentials/sq/sq.hpp>
 #include <cpp_essentials/core/container_helpers.hpp>
 
@@ -36,7 +38,7 @@ inline byte_mask create_structuring_element(size_type size, structuring_element
                 | sq::iterate()
                 | sq::for_each([&](auto&& it)
                 {
-                    auto d = it.location().as<float>() - center;
+                    auto d = it.location().template as<float>() - center;
                     auto pos = geo::elementwise_divide(2.F * d, size);
 
                     *it = geo::norm(pos) < 1.F ? 255 : 0;
@@ -58,6 +60,8 @@ using percentile_convolution_t = convolution_t<detail::percentile_tag, 1>;
 template <size_t D>
 using kernel_convolution_t = convolution_t<detail::kernel_tag, D>;
 
+using detail::separable_kernel_t;
+
 
 const byte_mask ellipse_3x3 = create_structuring_element({ 3, 3 }, structuring_element::ellipse);
 const byte_mask ellipse_5x5 = create_structuring_element({ 5, 5 }, structuring_element::ellipse);
@@ -94,14 +98,7 @@ inline auto median(byte_mask mask) -> percentile_convolution_t
 template <size_t D, class Tag>
 void convolve(byte_image::const_view_type source, byte_image::view_type dest, const convolution_t<Tag, D>& convolution)
 {
-    auto kernel_size = convolution.size();
-
-    auto size = detail::get_valid_size(source.size(), kernel_size);
-
-    core::transform(
-        source.region_range(kernel_size),
-        dest.region({ geo::zeros, size }).begin(),
-        convolution);
+    convolution.apply(source, dest);
 }
 
 template <size_t D, class Tag>
@@ -113,6 +110,67 @@ void convolve(rgb_image::const_view_type source, rgb_image::view_type dest, cons
     }
 }
 
+template <size_t D, class Tag>
+void convolve(const execution::sequenced_policy&, byte_image::const_view_type source, byte_image::view_type dest, const convolution_t<Tag, D>& convolution)
+{
+    convolve(source, dest, convolution);
+}
+
+template <size_t D, class Tag>
+void convolve(const execution::sequenced_policy&, rgb_image::const_view_type source, rgb_image::view_type dest, const convolution_t<Tag, D>& convolution)
+{
+    convolve(source, dest, convolution);
+}
+
+/* Splits the valid output region into row bands, each reading its own halo; every band works on a copy of the convolution so that scratch state is never shared. */
+template <size_t D, class Tag>
+void convolve(const execution::parallel_policy& policy, byte_image::const_view_type source, byte_image::view_type dest, const convolution_t<Tag, D>& convolution)
+{
+    const auto kernel_size = convolution.size();
+    const auto size = detail::get_valid_size(source.size(), kernel_size);
+
+    if (size.x() <= 0 || size.y() <= 0)
+    {
+        return;
+    }
+
+    detail::parallel_for_bands(policy, size.y(), std::max(16, 2 * kernel_size.y()), [&](int begin, int end)
+    {
+        const auto band = convolution;
+
+        band.apply(
+            source.region({ { 0, begin }, { source.width(), end + kernel_size.y() - 1 } }),
+            dest.region({ { 0, begin }, { dest.width(), end } }));
+    });
+}
+
+template <size_t D, class Tag>
+void convolve(const execution::parallel_policy& policy, rgb_image::const_view_type source, rgb_image::view_type dest, const convolution_t<Tag, D>& convolution)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        convolve(policy, channel(source, i), channel(dest, i), convolution);
+    }
+}
+
+template <size_t D, class Tag, size_t Channels>
+void convolve(const planar_image<byte, Channels>& source, planar_image<byte, Channels>& dest, const convolution_t<Tag, D>& convolution)
+{
+    transform_channels(source, dest, [&](byte_image::const_view_type src, byte_image::view_type dst)
+    {
+        convolve(src, dst, convolution);
+    });
+}
+
+template <size_t D, class Tag, size_t Channels, class Policy>
+void convolve(const Policy& policy, const planar_image<byte, Channels>& source, planar_image<byte, Channels>& dest, const convolution_t<Tag, D>& convolution)
+{
+    transform_channels(source, dest, [&](byte_image::const_view_type src, byte_image::view_type dst)
+    {
+        convolve(policy, src, dst, convolution);
+    });
+}
+
 } /* namespace cpp_essentials::gx */
 
 #endif /* CPP_ESSENTIALS_GX_MORPHOLOGICAL_OPERATIONS_HPP_ */
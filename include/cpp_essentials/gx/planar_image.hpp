@@ -0,0 +1,150 @@
+#ifndef CPP_ESSENTIALS_GX_PLANAR_IMAGE_HPP_
+#define CPP_ESSENTIALS_GX_PLANAR_IMAGE_HPP_
+
+#pragma once
+
+#include <array>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/planar_conversion.hpp>
+
+namespace cpp_essentials::gx
+{
+
+/* Image stored as one contiguous plane per channel; all planes share a single allocation, and channel views are zero-copy. */
+template <class T, size_t Channels>
+class planar_image
+{
+public:
+    using plane_type = image<T>;
+    using view_type = typename plane_type::view_type;
+    using const_view_type = typename plane_type::const_view_type;
+
+    static constexpr size_t channel_count = Channels;
+
+    planar_image()
+        : planar_image(size_type{})
+    {
+    }
+
+    explicit planar_image(const size_type& size)
+        : _size(size)
+        , _planes(size_type{ size.x(), size.y() * int(Channels) })
+    {
+    }
+
+    size_type size() const
+    {
+        return _size;
+    }
+
+    int width() const
+    {
+        return _size.x();
+    }
+
+    int height() const
+    {
+        return _size.y();
+    }
+
+    view_type channel(size_t index)
+    {
+        return _planes.region(plane_region(index));
+    }
+
+    const_view_type channel(size_t index) const
+    {
+        return _planes.region(plane_region(index));
+    }
+
+    std::array<view_type, Channels> channels()
+    {
+        return make_channels(*this, std::make_index_sequence<Channels>{});
+    }
+
+    std::array<const_view_type, Channels> channels() const
+    {
+        return make_channels(*this, std::make_index_sequence<Channels>{});
+    }
+
+private:
+    image_region_t plane_region(size_t index) const
+    {
+        EXPECTS(index < Channels, "channel index out of range");
+
+        return
+        {
+            location_type{ 0, int(index) * _size.y() },
+            location_type{ _size.x(), int(index + 1) * _size.y() }
+        };
+    }
+
+    template <class Self, size_t... I>
+    static auto make_channels(Self& self, std::index_sequence<I...>)
+    {
+        return std::array<decltype(self.channel(0)), Channels>{ { self.channel(I)... } };
+    }
+
+    size_type _size;
+    plane_type _planes;
+};
+
+using planar_rgb_image = planar_image<byte, 3>;
+using planar_rgba_image = planar_image<byte, 4>;
+
+inline void deinterleave(rgb_image::const_view_type source, planar_rgb_image& dest)
+{
+    EXPECTS(source.size() == dest.size(), "deinterleave: size mismatch");
+
+    detail::deinterleave_rows(source, dest.channels());
+}
+
+inline void deinterleave(rgba_image::const_view_type source, planar_rgba_image& dest)
+{
+    EXPECTS(source.size() == dest.size(), "deinterleave: size mismatch");
+
+    detail::deinterleave_rows(source, dest.channels());
+}
+
+inline planar_rgb_image deinterleave(rgb_image::const_view_type source)
+{
+    planar_rgb_image result{ source.size() };
+    deinterleave(source, result);
+    return result;
+}
+
+inline planar_rgba_image deinterleave(rgba_image::const_view_type source)
+{
+    planar_rgba_image result{ source.size() };
+    deinterleave(source, result);
+    return result;
+}
+
+inline void interleave(const planar_rgb_image& source, rgb_image::view_type dest)
+{
+    EXPECTS(source.size() == dest.size(), "interleave: size mismatch");
+
+    detail::interleave_rows(source.channels(), dest);
+}
+
+inline void interleave(const planar_rgba_image& source, rgba_image::view_type dest)
+{
+    EXPECTS(source.size() == dest.size(), "interleave: size mismatch");
+
+    detail::interleave_rows(source.channels(), dest);
+}
+
+/* Calls func(source.channel(i), dest.channel(i)) for every channel, e.g. to run a byte filter on contiguous planes. */
+template <class T, size_t Channels, class Func>
+void transform_channels(const planar_image<T, Channels>& source, planar_image<T, Channels>& dest, Func&& func)
+{
+    for (size_t i = 0; i < Channels; ++i)
+    {
+        func(source.channel(i), dest.channel(i));
+    }
+}
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_PLANAR_IMAGE_HPP_ */
@@ -0,0 +1,173 @@
+#ifndef CPP_ESSENTIALS_GX_PYRAMID_HPP_
+#define CPP_ESSENTIALS_GX_PYRAMID_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/pyramid_reduction.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+enum class pyramid_filter
+{
+    box,
+    gaussian
+};
+
+/* Successive half-resolution levels of an image, each (size + 1) / 2 of the previous one, kept in a single allocation:
+   level 0 on the left and the smaller levels stacked below each other to its right. */
+template <class T>
+class pyramid
+{
+public:
+    using level_type = image<T>;
+    using view_type = typename level_type::view_type;
+    using const_view_type = typename level_type::const_view_type;
+
+    pyramid()
+        : pyramid(size_type{}, 1)
+    {
+    }
+
+    /* levels are added, up to the requested count, until both sides are reduced to one pixel */
+    pyramid(const size_type& size, int levels)
+        : _regions(make_regions(size, levels))
+        , _storage_size(get_storage_size(_regions))
+        , _data(size_t(_storage_size.x()) * size_t(_storage_size.y()) * sizeof(T))
+    {
+    }
+
+    int levels() const
+    {
+        return int(_regions.size());
+    }
+
+    size_type size(int level) const
+    {
+        return region(level).size();
+    }
+
+    view_type level(int index)
+    {
+        return view_type{ reinterpret_cast<T*>(_data.data()), _storage_size }.region(region(index));
+    }
+
+    const_view_type level(int index) const
+    {
+        return const_view_type{ reinterpret_cast<const T*>(_data.data()), _storage_size }.region(region(index));
+    }
+
+    view_type operator [](int index)
+    {
+        return level(index);
+    }
+
+    const_view_type operator [](int index) const
+    {
+        return level(index);
+    }
+
+private:
+    const image_region_t& region(int index) const
+    {
+        EXPECTS(index >= 0 && index < levels(), "pyramid: level out of range");
+        return _regions[index];
+    }
+
+    static std::vector<image_region_t> make_regions(size_type size, int levels)
+    {
+        std::vector<image_region_t> result;
+
+        result.push_back({ location_type{ 0, 0 }, location_type{ size.x(), size.y() } });
+
+        location_type origin{ size.x(), 0 };
+
+        while (int(result.size()) < levels && (size.x() > 1 || size.y() > 1))
+        {
+            size = size_type{ detail::get_reduced_size(size.x()), detail::get_reduced_size(size.y()) };
+
+            result.push_back({ origin, location_type{ origin.x() + size.x(), origin.y() + size.y() } });
+
+            origin = location_type{ origin.x(), origin.y() + size.y() };
+        }
+
+        return result;
+    }
+
+    static size_type get_storage_size(const std::vector<image_region_t>& regions)
+    {
+        size_type result{ 0, 0 };
+
+        for (const auto& r : regions)
+        {
+            result = size_type{ std::max(result.x(), r.upper().x()), std::max(result.y(), r.upper().y()) };
+        }
+
+        return result;
+    }
+
+    std::vector<image_region_t> _regions;
+    size_type _storage_size;
+    /* raw bytes rather than a level_type, whose constructor assigns T{} to every pixel of the zeroed storage again */
+    std::vector<byte> _data;
+};
+
+namespace detail
+{
+
+struct build_pyramid_fn
+{
+    pyramid<byte> operator ()(byte_image::const_view_type source, int levels, pyramid_filter filter = pyramid_filter::box) const
+    {
+        return build<1>(source, levels, filter);
+    }
+
+    pyramid<rgb_color> operator ()(rgb_image::const_view_type source, int levels, pyramid_filter filter = pyramid_filter::box) const
+    {
+        return build<3>(source, levels, filter);
+    }
+
+    pyramid<rgba_color> operator ()(rgba_image::const_view_type source, int levels, pyramid_filter filter = pyramid_filter::box) const
+    {
+        return build<4>(source, levels, filter);
+    }
+
+private:
+    /* Each level is reduced from the previous one, whose rows are contiguous within the pyramid. */
+    template <size_t Channels, class View>
+    static pyramid<typename View::value_type> build(const View& source, int levels, pyramid_filter filter)
+    {
+        pyramid<typename View::value_type> result{ source.size(), levels };
+
+        copy_view(source, result.level(0));
+
+        const auto level = get_simd_level();
+
+        for (int i = 1; i < result.levels(); ++i)
+        {
+            if (filter == pyramid_filter::gaussian)
+            {
+                gaussian_reduce<Channels>(result.level(i - 1), result.level(i), level);
+            }
+            else
+            {
+                box_reduce<Channels>(result.level(i - 1), result.level(i), level);
+            }
+        }
+
+        return result;
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto build_pyramid = detail::build_pyramid_fn{};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_PYRAMID_HPP_ */
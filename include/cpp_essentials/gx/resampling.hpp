@@ -0,0 +1,155 @@
+#ifndef CPP_ESSENTIALS_GX_RESAMPLING_HPP_
+#define CPP_ESSENTIALS_GX_RESAMPLING_HPP_
+
+#pragma once
+
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/execution.hpp>
+#include <cpp_essentials/gx/detail/resampling.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+/* Separable resampling between two fixed sizes. The weight tables are computed once, so a resampler can be reused for
+   every image of the same size, e.g. when generating thumbnails. */
+class resampler
+{
+public:
+    resampler(const size_type& source_size, const size_type& dest_size, resampling_filter filter = resampling_filter::bilinear)
+        : _source_size(source_size)
+        , _dest_size(dest_size)
+        , _horizontal(detail::make_resampling_weights(source_size.x(), dest_size.x(), filter))
+        , _vertical(detail::make_resampling_weights(source_size.y(), dest_size.y(), filter))
+    {
+    }
+
+    size_type source_size() const
+    {
+        return _source_size;
+    }
+
+    size_type dest_size() const
+    {
+        return _dest_size;
+    }
+
+    void operator ()(byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        apply(source, dest, 0, dest.height());
+    }
+
+    void operator ()(rgb_image::const_view_type source, rgb_image::view_type dest) const
+    {
+        apply(source, dest, 0, dest.height());
+    }
+
+    void operator ()(rgba_image::const_view_type source, rgba_image::view_type dest) const
+    {
+        apply(source, dest, 0, dest.height());
+    }
+
+    void operator ()(image<float>::const_view_type source, image<float>::view_type dest) const
+    {
+        apply(source, dest, 0, dest.height());
+    }
+
+    void operator ()(const execution::parallel_policy& policy, byte_image::const_view_type source, byte_image::view_type dest) const
+    {
+        apply(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgb_image::const_view_type source, rgb_image::view_type dest) const
+    {
+        apply(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgba_image::const_view_type source, rgba_image::view_type dest) const
+    {
+        apply(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, image<float>::const_view_type source, image<float>::view_type dest) const
+    {
+        apply(policy, source, dest);
+    }
+
+private:
+    template <class SourceView, class DestView>
+    void apply(const SourceView& source, const DestView& dest, int begin, int end) const
+    {
+        EXPECTS(source.size() == _source_size && dest.size() == _dest_size, "resampler: size mismatch");
+        EXPECTS(detail::is_contiguous_row(source) && detail::is_contiguous_row(dest), "resampler: rows must be contiguous");
+
+        detail::resample_rows(_horizontal, _vertical, source, dest, begin, end, detail::get_simd_level());
+    }
+
+    /* Each band of destination rows keeps its own row cache; source rows shared by neighbouring bands are resampled by both. */
+    template <class SourceView, class DestView>
+    void apply(const execution::parallel_policy& policy, const SourceView& source, const DestView& dest) const
+    {
+        detail::parallel_for_bands(policy, dest.height(), 32, [&](int begin, int end)
+        {
+            apply(source, dest, begin, end);
+        });
+    }
+
+    size_type _source_size;
+    size_type _dest_size;
+    detail::resampling_weights _horizontal;
+    detail::resampling_weights _vertical;
+};
+
+namespace detail
+{
+
+struct resize_fn
+{
+    void operator ()(byte_image::const_view_type source, byte_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(source, dest);
+    }
+
+    void operator ()(rgb_image::const_view_type source, rgb_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(source, dest);
+    }
+
+    void operator ()(rgba_image::const_view_type source, rgba_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(source, dest);
+    }
+
+    void operator ()(image<float>::const_view_type source, image<float>::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, byte_image::const_view_type source, byte_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgb_image::const_view_type source, rgb_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, rgba_image::const_view_type source, rgba_image::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(policy, source, dest);
+    }
+
+    void operator ()(const execution::parallel_policy& policy, image<float>::const_view_type source, image<float>::view_type dest, resampling_filter filter = resampling_filter::bilinear) const
+    {
+        resampler{ source.size(), dest.size(), filter }(policy, source, dest);
+    }
+};
+
+} /* namespace detail */
+
+static constexpr auto resize = detail::resize_fn{};
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_RESAMPLING_HPP_ */
@@ -0,0 +1,334 @@
+#ifndef CPP_ESSENTIALS_GX_TILED_IMAGE_HPP_
+#define CPP_ESSENTIALS_GX_TILED_IMAGE_HPP_
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cpp_essentials/core/assertions.hpp>
+#include <cpp_essentials/gx/image.hpp>
+#include <cpp_essentials/gx/detail/row_access.hpp>
+
+namespace cpp_essentials::gx
+{
+
+/* Image split into fixed-size tiles of which at most `capacity` are resident; the others live in a paging file, so the image
+   may be much larger than the available memory. Tiles never written read as T{}. The paging file is removed on destruction.
+   Views of a resident tile are invalidated by the next access to another tile of the same image. */
+template <class T>
+class tiled_image
+{
+public:
+    using tile_type = image<T>;
+    using view_type = typename tile_type::view_type;
+    using const_view_type = typename tile_type::const_view_type;
+
+    tiled_image(const size_type& size, const size_type& tile_size, std::string file, size_t capacity = 16)
+        : _size(size)
+        , _tile_size(tile_size)
+        , _grid{ (size.x() + tile_size.x() - 1) / tile_size.x(), (size.y() + tile_size.y() - 1) / tile_size.y() }
+        , _file(std::move(file))
+        , _capacity(std::max<size_t>(capacity, 1))
+        , _stored(size_t(_grid.x()) * size_t(_grid.y()), false)
+    {
+        EXPECTS(tile_size.x() > 0 && tile_size.y() > 0, "tiled_image: invalid tile size");
+
+        _stream.open(_file, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!_stream)
+        {
+            throw std::runtime_error{ "tiled_image: cannot open " + _file };
+        }
+    }
+
+    tiled_image(const tiled_image&) = delete;
+    tiled_image& operator =(const tiled_image&) = delete;
+
+    ~tiled_image()
+    {
+        _stream.close();
+        std::remove(_file.c_str());
+    }
+
+    size_type size() const
+    {
+        return _size;
+    }
+
+    int width() const
+    {
+        return _size.x();
+    }
+
+    int height() const
+    {
+        return _size.y();
+    }
+
+    image_bounds_t bounds() const
+    {
+        return { location_type{ 0, 0 }, location_type{ _size.x(), _size.y() } };
+    }
+
+    size_type tile_size() const
+    {
+        return _tile_size;
+    }
+
+    /* number of tiles in each direction */
+    size_type grid() const
+    {
+        return _grid;
+    }
+
+    /* pixels covered by a tile, clipped to the image bounds */
+    image_region_t tile_region(const location_type& tile) const
+    {
+        const location_type lower{ tile.x() * _tile_size.x(), tile.y() * _tile_size.y() };
+        const location_type upper{ std::min(lower.x() + _tile_size.x(), _size.x()), std::min(lower.y() + _tile_size.y(), _size.y()) };
+
+        return { lower, upper };
+    }
+
+    /* view of a single resident tile, paging it in if needed */
+    view_type tile(const location_type& tile)
+    {
+        return resident(tile, true).region(local_region(tile));
+    }
+
+    const_view_type tile(const location_type& tile) const
+    {
+        return resident(tile, false).region(local_region(tile));
+    }
+
+    /* copies an arbitrary region, which may span several tiles, into dest */
+    void read(const image_region_t& region, view_type dest) const
+    {
+        EXPECTS(region.size() == dest.size(), "tiled_image: size mismatch");
+
+        visit_tiles(region, [&](const location_type& tile, const image_region_t& part)
+        {
+            detail::copy_view(
+                resident(tile, false).region(shift(part, tile_origin(tile))),
+                dest.region(shift(part, region.lower())));
+        });
+    }
+
+    void write(const image_region_t& region, const_view_type source)
+    {
+        EXPECTS(region.size() == source.size(), "tiled_image: size mismatch");
+
+        visit_tiles(region, [&](const location_type& tile, const image_region_t& part)
+        {
+            detail::copy_view(
+                source.region(shift(part, region.lower())),
+                resident(tile, true).region(shift(part, tile_origin(tile))));
+        });
+    }
+
+    /* writes modified resident tiles to the paging file */
+    void flush() const
+    {
+        for (auto& entry : _cache)
+        {
+            store(entry);
+        }
+
+        _stream.flush();
+    }
+
+    /* Calls func(tile) for each tile intersecting region, with the tile's clipped pixel region. */
+    template <class Func>
+    void visit_tiles(const image_region_t& region, Func&& func) const
+    {
+        const auto clipped = detail::intersect(region, bounds());
+
+        if (detail::is_empty(clipped))
+        {
+            return;
+        }
+
+        const auto first = location_type{ clipped.lower().x() / _tile_size.x(), clipped.lower().y() / _tile_size.y() };
+        const auto last = location_type{ (clipped.upper().x() - 1) / _tile_size.x(), (clipped.upper().y() - 1) / _tile_size.y() };
+
+        for (int ty = first.y(); ty <= last.y(); ++ty)
+        {
+            for (int tx = first.x(); tx <= last.x(); ++tx)
+            {
+                const location_type tile{ tx, ty };
+                func(tile, detail::intersect(clipped, tile_region(tile)));
+            }
+        }
+    }
+
+private:
+    struct entry_type
+    {
+        size_t index;
+        tile_type data;
+        bool dirty;
+    };
+
+    using cache_type = std::list<entry_type>;
+
+    size_t tile_index(const location_type& tile) const
+    {
+        EXPECTS(tile.x() >= 0 && tile.x() < _grid.x() && tile.y() >= 0 && tile.y() < _grid.y(), "tiled_image: tile out of range");
+        return size_t(tile.y()) * size_t(_grid.x()) + size_t(tile.x());
+    }
+
+    location_type tile_origin(const location_type& tile) const
+    {
+        return { tile.x() * _tile_size.x(), tile.y() * _tile_size.y() };
+    }
+
+    image_region_t local_region(const location_type& tile) const
+    {
+        return shift(tile_region(tile), tile_origin(tile));
+    }
+
+    static image_region_t shift(const image_region_t& region, const location_type& origin)
+    {
+        return { region.lower() - origin, region.upper() - origin };
+    }
+
+    size_t tile_bytes() const
+    {
+        return size_t(_tile_size.x()) * size_t(_tile_size.y()) * bytes_per_pixel<T>::value;
+    }
+
+    std::streamoff tile_offset(size_t index) const
+    {
+        return std::streamoff(index) * std::streamoff(tile_bytes());
+    }
+
+    /* most recently used tiles are kept at the front */
+    tile_type& resident(const location_type& tile, bool modify) const
+    {
+        const auto index = tile_index(tile);
+
+        auto it = _lookup.find(index);
+
+        if (it != _lookup.end())
+        {
+            _cache.splice(_cache.begin(), _cache, it->second);
+        }
+        else
+        {
+            if (_cache.size() >= _capacity)
+            {
+                store(_cache.back());
+                _lookup.erase(_cache.back().index);
+                _cache.pop_back();
+            }
+
+            _cache.push_front(entry_type{ index, tile_type{ _tile_size }, false });
+            load(_cache.front());
+            _lookup.emplace(index, _cache.begin());
+        }
+
+        auto& entry = _cache.front();
+        entry.dirty = entry.dirty || modify;
+        return entry.data;
+    }
+
+    void load(entry_type& entry) const
+    {
+        if (!_stored[entry.index])
+        {
+            return;
+        }
+
+        _stream.seekg(tile_offset(entry.index));
+        _stream.read(reinterpret_cast<char*>(entry.data.data()), std::streamsize(tile_bytes()));
+
+        if (!_stream)
+        {
+            throw std::runtime_error{ "tiled_image: cannot read " + _file };
+        }
+    }
+
+    void store(entry_type& entry) const
+    {
+        if (!entry.dirty)
+        {
+            return;
+        }
+
+        _stream.seekp(tile_offset(entry.index));
+        _stream.write(reinterpret_cast<const char*>(entry.data.data()), std::streamsize(tile_bytes()));
+
+        if (!_stream)
+        {
+            throw std::runtime_error{ "tiled_image: cannot write " + _file };
+        }
+
+        _stored[entry.index] = true;
+        entry.dirty = false;
+    }
+
+    size_type _size;
+    size_type _tile_size;
+    size_type _grid;
+    std::string _file;
+    size_t _capacity;
+    mutable std::fstream _stream;
+    mutable std::vector<bool> _stored;
+    mutable cache_type _cache;
+    mutable std::unordered_map<size_t, typename cache_type::iterator> _lookup;
+};
+
+/* Calls func(view, region) for every tile intersecting region (the whole image by default), where view covers the tile's
+   pixels inside region and may be modified in place. */
+template <class T, class Func>
+void for_each_tile(tiled_image<T>& image, const image_region_t& region, Func&& func)
+{
+    image.visit_tiles(region, [&](const location_type& tile, const image_region_t& part)
+    {
+        const auto origin = image.tile_region(tile).lower();
+        func(image.tile(tile).region({ part.lower() - origin, part.upper() - origin }), part);
+    });
+}
+
+template <class T, class Func>
+void for_each_tile(tiled_image<T>& image, Func&& func)
+{
+    for_each_tile(image, image.bounds(), std::forward<Func>(func));
+}
+
+/* For every tile of dest, reads the matching source region extended by `halo` pixels to the right and bottom into memory and
+   calls func(source_view, dest_view); this matches the valid-region anchoring of convolve, whose halo is kernel size - 1.
+   Only the part of dest that has a complete source window is visited. source and dest must be different images. */
+template <class T, class U, class Func>
+void transform_tiles(const tiled_image<T>& source, tiled_image<U>& dest, const size_type& halo, Func&& func)
+{
+    EXPECTS(static_cast<const void*>(&source) != &dest, "transform_tiles: source and dest must be different images");
+
+    const image_region_t valid
+    {
+        location_type{ 0, 0 },
+        location_type{ std::min(dest.width(), source.width() - halo.x()), std::min(dest.height(), source.height() - halo.y()) }
+    };
+
+    image<T> buffer{ dest.tile_size() + halo };
+
+    for_each_tile(dest, valid, [&](typename tiled_image<U>::view_type dest_view, const image_region_t& part)
+    {
+        const image_region_t input{ part.lower(), part.upper() + halo };
+        const auto source_view = buffer.region({ location_type{ 0, 0 }, location_type{ input.size() } });
+
+        source.read(input, source_view);
+        func(typename tiled_image<T>::const_view_type{ source_view }, dest_view);
+    });
+}
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_TILED_IMAGE_HPP_ */
@@ -0,0 +1,85 @@
+#ifndef CPP_ESSENTIALS_GX_TILED_OPERATIONS_HPP_
+#define CPP_ESSENTIALS_GX_TILED_OPERATIONS_HPP_
+
+#pragma once
+
+#include <array>
+
+#include <cpp_essentials/gx/histogram_operations.hpp>
+#include <cpp_essentials/gx/lookup_table.hpp>
+#include <cpp_essentials/gx/morphological_operations.hpp>
+#include <cpp_essentials/gx/tiled_image.hpp>
+
+namespace cpp_essentials::gx
+{
+
+template <class Lut, class T, class U>
+void apply(const Lut& lut, const tiled_image<T>& source, tiled_image<U>& dest)
+{
+    transform_tiles(source, dest, size_type{ 0, 0 }, [&](auto src, auto dst)
+    {
+        apply(lut, src, dst);
+    });
+}
+
+/* Convolves tile by tile; each tile reads its kernel halo from the neighbouring tiles of the source. */
+template <class T, size_t D, class Tag>
+void convolve(const tiled_image<T>& source, tiled_image<T>& dest, const convolution_t<Tag, D>& convolution)
+{
+    transform_tiles(source, dest, convolution.size() - size_type{ 1, 1 }, [&](auto src, auto dst)
+    {
+        convolve(src, dst, convolution);
+    });
+}
+
+namespace detail
+{
+
+/* Tiles are visited in storage order, each paged in once. */
+template <size_t Channels, class T>
+std::array<histogram_t, Channels> make_histograms(const tiled_image<T>& image)
+{
+    histogram_counter<Channels> counter;
+
+    for (int y = 0; y < image.grid().y(); ++y)
+    {
+        for (int x = 0; x < image.grid().x(); ++x)
+        {
+            counter.add(image.tile({ x, y }));
+        }
+    }
+
+    return counter.result();
+}
+
+inline histogram_t make_histogram(const tiled_image<byte>& image)
+{
+    return make_histograms<1>(image)[0];
+}
+
+inline rgb_histogram_t make_histogram(const tiled_image<rgb_color>& image)
+{
+    return make_histograms<3>(image);
+}
+
+/* The tiled overloads of equalize, stretch and otsu. */
+template <class Op>
+void apply_histogram_operation(const Op& op, const tiled_image<byte>& source, tiled_image<byte>& dest)
+{
+    apply(op(make_histogram(source)), source, dest);
+}
+
+template <class Op>
+void apply_histogram_operation(const Op& op, const tiled_image<rgb_color>& source, tiled_image<rgb_color>& dest)
+{
+    const auto histograms = make_histogram(source);
+    const std::array<lookup_table, 3> luts = { op(histograms[0]), op(histograms[1]), op(histograms[2]) };
+
+    apply(luts, source, dest);
+}
+
+} /* namespace detail */
+
+} /* namespace cpp_essentials::gx */
+
+#endif /* CPP_ESSENTIALS_GX_TILED_OPERATIONS_HPP_ */
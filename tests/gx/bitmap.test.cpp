@@ -0,0 +1,157 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/bitmap.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+TEST_CASE("swap red and blue")
+{
+    const auto source = test_helpers::make_test_image<gx::rgb_color>({ 37, 1 });
+    const auto* src = reinterpret_cast<const gx::byte*>(source.data());
+
+    std::vector<gx::byte> expected(3 * 37);
+    gx::detail::swap_red_blue(src, 3, expected.data(), 37, gx::detail::simd_level::none);
+
+    for (int x = 0; x < 37; ++x)
+    {
+        REQUIRE(expected[3 * x + 0] == source[0][x].blue());
+        REQUIRE(expected[3 * x + 1] == source[0][x].green());
+        REQUIRE(expected[3 * x + 2] == source[0][x].red());
+    }
+
+    std::vector<gx::byte> actual(src, src + 3 * 37);
+    gx::detail::swap_red_blue(actual.data(), 3, actual.data(), 37);
+
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("save and load 24-bit bitmap")
+{
+    for (int width : { 1, 2, 3, 17, 54 })
+    {
+        const auto source = test_helpers::make_test_image<gx::rgb_color>({ width, 5 });
+
+        std::stringstream stream;
+        gx::save_bitmap(source, stream);
+
+        REQUIRE(stream.str().size() == 54 + 5 * (3 * width + gx::detail::get_padding(width, 24)));
+
+        const auto result = gx::load_bitmap(stream);
+
+        REQUIRE(result.size() == source.size());
+        REQUIRE(core::equal(result, source, [](const gx::rgb_color& lhs, const gx::rgb_color& rhs)
+        {
+            return lhs.red() == rhs.red() && lhs.green() == rhs.green() && lhs.blue() == rhs.blue();
+        }));
+    }
+}
+
+TEST_CASE("save and load 8-bit bitmap")
+{
+    for (int width : { 1, 6, 33 })
+    {
+        gx::byte_image source{ { width, 4 } };
+
+        for (auto it : core::views::iterate(source))
+        {
+            *it = gx::byte(it.location().x() * 11 + it.location().y() * 50);
+        }
+
+        std::stringstream stream;
+        gx::save_bitmap(source, stream);
+
+        const auto result = gx::load_bitmap(stream);
+
+        REQUIRE(result.size() == source.size());
+        REQUIRE(core::equal(result, source, [](const gx::rgb_color& lhs, gx::byte rhs)
+        {
+            return lhs.red() == rhs && lhs.green() == rhs && lhs.blue() == rhs;
+        }));
+    }
+}
+
+TEST_CASE("map 24-bit bitmap")
+{
+    const std::string file = "map_bitmap.test.bmp";
+
+    const auto source = test_helpers::make_test_image<gx::rgb_color>({ 13, 6 });
+    gx::save_bitmap(source, file);
+
+    {
+        const auto mapped = gx::map_bitmap(file);
+
+        REQUIRE(mapped.size() == source.size());
+        REQUIRE(mapped.view().stride()[1] < 0);
+        REQUIRE(core::equal(mapped.view(), source, [](const gx::bgr_color& lhs, const gx::rgb_color& rhs)
+        {
+            return lhs.to_rgb() == rhs;
+        }));
+
+        const auto crop = mapped.view().region({ { 2, 1 }, { 7, 4 } });
+
+        REQUIRE(crop.size() == gx::size_type{ 5, 3 });
+        REQUIRE(crop[{ 0, 0 }].to_rgb() == source[1][2]);
+        REQUIRE(crop[{ 4, 2 }].to_rgb() == source[3][6]);
+    }
+
+    std::remove(file.c_str());
+
+    REQUIRE_THROWS(gx::map_bitmap(file));
+}
+
+TEST_CASE("map bitmap larger than the view can address")
+{
+    const std::string file = "map_bitmap_large.test.bmp";
+
+    const auto write_header = [&](std::int32_t width, std::int32_t height)
+    {
+        char header[54] = {};
+        const std::uint32_t data_offset = 54;
+        const std::uint16_t bits_per_pixel = 24;
+
+        header[0] = 'B';
+        header[1] = 'M';
+        std::memcpy(header + 10, &data_offset, 4);
+        std::memcpy(header + 18, &width, 4);
+        std::memcpy(header + 22, &height, 4);
+        std::memcpy(header + 28, &bits_per_pixel, 2);
+
+        std::ofstream fs(file.c_str(), std::ofstream::binary);
+        fs.write(header, sizeof(header));
+    };
+
+    const auto error_message = [&]() -> std::string
+    {
+        try
+        {
+            gx::map_bitmap(file);
+        }
+        catch (const std::runtime_error& ex)
+        {
+            return ex.what();
+        }
+
+        return {};
+    };
+
+    /* no pixel data follows the headers; the size alone must be rejected */
+    write_header(40000, -60000);
+    REQUIRE(error_message() == "map_bitmap: file too large");
+
+    write_header(40000, 60000);
+    REQUIRE(error_message() == "map_bitmap: file too large");
+
+    write_header(1, std::numeric_limits<std::int32_t>::min());
+    REQUIRE(error_message() == "map_bitmap: file too large");
+
+    write_header(4, 3);
+    REQUIRE(error_message() == "map_bitmap: truncated file");
+
+    std::remove(file.c_str());
+}
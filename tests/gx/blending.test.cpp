@@ -0,0 +1,161 @@
+#include <catch.hpp>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/blending.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+template <class Filter>
+gx::rgb_image blend_reference(const gx::rgb_image& lhs, const gx::rgb_image& rhs, const Filter& filter)
+{
+    gx::rgb_image result{ lhs.size() };
+
+    for (auto it : core::views::iterate(result))
+    {
+        *it = filter(lhs[it.location()], rhs[it.location()]);
+    }
+
+    return result;
+}
+
+template <class Filter>
+void check_mode(gx::blend_mode mode, const Filter& filter)
+{
+    const auto lhs = test_helpers::make_test_image<gx::rgb_color>({ 83, 29 }, 11);
+    const auto rhs = test_helpers::make_test_image<gx::rgb_color>({ 83, 29 }, 97);
+
+    const auto expected = blend_reference(lhs, rhs, filter);
+
+    gx::rgb_image actual{ lhs.size() };
+    gx::blend_images(mode, lhs, rhs, actual);
+
+    REQUIRE(core::equal(actual, expected));
+
+    gx::rgb_image parallel{ lhs.size() };
+    gx::blend_images(gx::execution::par(3), mode, lhs, rhs, parallel);
+
+    REQUIRE(core::equal(parallel, expected));
+}
+
+} /* namespace */
+
+TEST_CASE("blend modes match the color filters")
+{
+    check_mode(gx::blend_mode::normal, gx::filters::normal{});
+    check_mode(gx::blend_mode::darker, gx::filters::darker{});
+    check_mode(gx::blend_mode::lighter, gx::filters::lighter{});
+    check_mode(gx::blend_mode::multiply, gx::filters::multiply{});
+    check_mode(gx::blend_mode::screen, gx::filters::screen{});
+    check_mode(gx::blend_mode::overlay, gx::filters::overlay{});
+    check_mode(gx::blend_mode::difference, gx::filters::difference{});
+    check_mode(gx::blend_mode::add, gx::filters::add{});
+    check_mode(gx::blend_mode::subtract, gx::filters::subtract{});
+}
+
+TEST_CASE("blend modes cover all byte pairs")
+{
+    gx::byte_image lhs{ { 256, 256 } };
+    gx::byte_image rhs{ { 256, 256 } };
+
+    for (auto it : core::views::iterate(lhs))
+    {
+        *it = gx::byte(it.location().x());
+        rhs[it.location()] = gx::byte(it.location().y());
+    }
+
+    for (auto mode : { gx::blend_mode::multiply, gx::blend_mode::screen, gx::blend_mode::overlay, gx::blend_mode::subtract })
+    {
+        gx::byte_image actual{ lhs.size() };
+        gx::blend_images(mode, lhs, rhs, actual);
+
+        gx::byte_image expected{ lhs.size() };
+
+        for (int y = 0; y < lhs.height(); ++y)
+        {
+            gx::detail::blend_row(mode, lhs.data({ 0, y }), rhs.data({ 0, y }), expected.data({ 0, y }), lhs.width(), gx::detail::simd_level::none);
+        }
+
+        REQUIRE(core::equal(actual, expected));
+    }
+}
+
+TEST_CASE("blend with alpha mask")
+{
+    const auto lhs = test_helpers::make_test_image<gx::rgb_color>({ 45, 38 }, 3);
+    const auto rhs = test_helpers::make_test_image<gx::rgb_color>({ 45, 38 }, 71);
+
+    gx::byte_image mask{ lhs.size() };
+
+    for (auto it : core::views::iterate(mask))
+    {
+        *it = gx::byte((it.location().x() * 17 + it.location().y() * 5) % 256);
+    }
+
+    gx::rgb_image actual{ lhs.size() };
+    gx::blend_images(gx::blend_mode::screen, lhs, rhs, mask, actual);
+
+    const auto blended = blend_reference(lhs, rhs, gx::filters::screen{});
+
+    for (auto it : core::views::iterate(actual))
+    {
+        const auto loc = it.location();
+        const auto a = mask[loc];
+
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const auto expected = int(std::floor((blended[loc][c] * a + lhs[loc][c] * (255 - a)) / 255.0 + 0.5));
+            REQUIRE(int((*it)[c]) == expected);
+        }
+    }
+
+    /* in place, on a sub-region */
+    auto target = lhs;
+    const gx::image_region_t region{ { 3, 4 }, { 40, 31 } };
+
+    gx::blend_images(
+        gx::blend_mode::screen,
+        target.view().region(region),
+        rhs.view().region(region),
+        mask.view().region(region),
+        target.view().region(region));
+
+    REQUIRE(core::equal(target.view().region(region), actual.view().region(region)));
+}
+
+TEST_CASE("blend ratio")
+{
+    const auto lhs = test_helpers::make_test_image<gx::rgb_color>({ 77, 23 }, 5);
+    const auto rhs = test_helpers::make_test_image<gx::rgb_color>({ 77, 23 }, 59);
+
+    for (auto ratio : { 0.F, 0.25F, 0.5F, 0.8F, 1.F })
+    {
+        const auto expected = blend_reference(lhs, rhs, gx::filters::blend{ ratio });
+
+        gx::rgb_image actual{ lhs.size() };
+        gx::blend_images(ratio, lhs, rhs, actual);
+
+        const auto weight = int(ratio * 255.F + 0.5F);
+
+        for (auto it : core::views::iterate(actual))
+        {
+            const auto loc = it.location();
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                /* the exact rounded mix, at most one above the truncating filter */
+                const auto mixed = int(std::floor((rhs[loc][c] * weight + lhs[loc][c] * (255 - weight)) / 255.0 + 0.5));
+                REQUIRE(int((*it)[c]) == mixed);
+                REQUIRE(int((*it)[c]) - int(expected[loc][c]) >= 0);
+                REQUIRE(int((*it)[c]) - int(expected[loc][c]) <= 1);
+            }
+        }
+
+        gx::rgb_image parallel{ lhs.size() };
+        gx::blend_images(gx::execution::par(3), ratio, lhs, rhs, parallel);
+
+        REQUIRE(core::equal(parallel, actual));
+    }
+}
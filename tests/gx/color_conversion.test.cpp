@@ -0,0 +1,149 @@
+#include <catch.hpp>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/color_conversion.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+gx::rgb_image make_color_image(const gx::image_size_t& size)
+{
+    auto result = test_helpers::make_test_image<gx::rgb_color>(size);
+
+    /* gray pixels, where hue and saturation are degenerate */
+    result[{ 0, 0 }] = gx::rgb_color(0, 0, 0);
+    result[{ 1, 0 }] = gx::rgb_color(255, 255, 255);
+    result[{ 2, 0 }] = gx::rgb_color(90, 90, 90);
+
+    return result;
+}
+
+template <size_t Channels>
+gx::planar_image<float, Channels> convert(gx::color_space space, const gx::rgb_image& image)
+{
+    gx::planar_image<float, Channels> result{ image.size() };
+    gx::to_color_space(space, image, result);
+    return result;
+}
+
+template <size_t Channels>
+void check_round_trip(gx::color_space space, const gx::rgb_image& image)
+{
+    const auto planes = convert<Channels>(space, image);
+
+    gx::rgb_image result{ image.size() };
+    gx::from_color_space(space, planes, result);
+
+    REQUIRE(core::equal(result, image));
+}
+
+} /* namespace */
+
+TEST_CASE("batched conversion matches per-pixel conversion")
+{
+    const auto image = make_color_image({ 67, 23 });
+
+    const auto hsv = convert<3>(gx::color_space::hsv, image);
+    const auto hsl = convert<3>(gx::color_space::hsl, image);
+    const auto yuv = convert<3>(gx::color_space::yuv, image);
+    const auto yiq = convert<3>(gx::color_space::yiq, image);
+    const auto cmyk = convert<4>(gx::color_space::cmyk, image);
+
+    for (auto it : core::views::iterate(image))
+    {
+        const auto loc = it.location();
+
+        const auto expected_hsv = gx::to_hsv(*it);
+        REQUIRE(hsv.channel(0)[loc] == Approx(expected_hsv.h).margin(1e-3));
+        REQUIRE(hsv.channel(1)[loc] == Approx(expected_hsv.s).margin(1e-5));
+        REQUIRE(hsv.channel(2)[loc] == Approx(expected_hsv.v).margin(1e-5));
+
+        const auto expected_hsl = gx::to_hsl(*it);
+        REQUIRE(hsl.channel(0)[loc] == Approx(expected_hsl.h).margin(1e-3));
+        REQUIRE(hsl.channel(1)[loc] == Approx(expected_hsl.s).margin(1e-5));
+        REQUIRE(hsl.channel(2)[loc] == Approx(expected_hsl.l).margin(1e-5));
+
+        const auto expected_yuv = gx::to_yuv(*it);
+        REQUIRE(yuv.channel(0)[loc] == Approx(expected_yuv.y).margin(1e-3));
+        REQUIRE(yuv.channel(1)[loc] == Approx(expected_yuv.u).margin(1e-3));
+        REQUIRE(yuv.channel(2)[loc] == Approx(expected_yuv.v).margin(1e-3));
+
+        const auto expected_yiq = gx::to_yiq(*it);
+        REQUIRE(yiq.channel(0)[loc] == Approx(expected_yiq.y).margin(1e-3));
+        REQUIRE(yiq.channel(1)[loc] == Approx(expected_yiq.i).margin(1e-3));
+        REQUIRE(yiq.channel(2)[loc] == Approx(expected_yiq.q).margin(1e-3));
+
+        const auto expected_cmyk = gx::to_cmyk(*it);
+        REQUIRE(cmyk.channel(0)[loc] == Approx(expected_cmyk.c).margin(1e-5));
+        REQUIRE(cmyk.channel(1)[loc] == Approx(expected_cmyk.m).margin(1e-5));
+        REQUIRE(cmyk.channel(2)[loc] == Approx(expected_cmyk.y).margin(1e-5));
+        REQUIRE(cmyk.channel(3)[loc] == Approx(expected_cmyk.k).margin(1e-5));
+    }
+}
+
+TEST_CASE("batched conversion round trip")
+{
+    const auto image = make_color_image({ 53, 31 });
+
+    check_round_trip<3>(gx::color_space::hsv, image);
+    check_round_trip<3>(gx::color_space::hsl, image);
+    check_round_trip<3>(gx::color_space::yuv, image);
+    check_round_trip<3>(gx::color_space::yiq, image);
+    check_round_trip<4>(gx::color_space::cmyk, image);
+}
+
+TEST_CASE("simd conversion matches scalar")
+{
+    const auto image = make_color_image({ 61, 17 });
+
+    gx::planar_image<float, 3> scalar{ image.size() };
+    gx::planar_image<float, 3> simd{ image.size() };
+
+    const gx::detail::hsl_conversion conversion{};
+    const gx::detail::forward_conversion<gx::detail::hsl_conversion> forward{ conversion };
+
+    gx::detail::rgb_to_planes(forward, image, scalar.channels(), 0, image.height(), gx::detail::simd_level::none);
+    gx::detail::rgb_to_planes(forward, image, simd.channels(), 0, image.height(), gx::detail::get_simd_level());
+
+    for (size_t c = 0; c < 3; ++c)
+    {
+        REQUIRE(core::equal(scalar.channel(c), simd.channel(c)));
+    }
+}
+
+TEST_CASE("adjust hue and saturation")
+{
+    const auto image = make_color_image({ 77, 19 });
+
+    auto hsv = convert<3>(gx::color_space::hsv, image);
+
+    for (auto& h : hsv.channel(0))
+    {
+        h += 40.F;
+    }
+
+    for (auto& s : hsv.channel(1))
+    {
+        s = std::min(s * 1.5F, 1.F);
+    }
+
+    gx::rgb_image expected{ image.size() };
+    gx::from_color_space(gx::color_space::hsv, hsv, expected);
+
+    gx::rgb_image actual{ image.size() };
+    gx::adjust_hue_saturation(image, actual, 40.F, 1.5F);
+
+    REQUIRE(core::equal(actual, expected));
+
+    auto in_place = image;
+    gx::adjust_hue_saturation(gx::execution::par(2), in_place, in_place, 40.F, 1.5F);
+
+    REQUIRE(core::equal(in_place, expected));
+
+    gx::rgb_image identity{ image.size() };
+    gx::adjust_hue_saturation(image, identity, 360.F, 1.F);
+
+    REQUIRE(core::equal(identity, image));
+}
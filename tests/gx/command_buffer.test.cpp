@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include <random>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/command_buffer.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+gx::command_buffer<gx::rgb_color> make_scene(const gx::size_type& size)
+{
+    std::mt19937 engine{ 7 };
+    std::uniform_int_distribution<int> x_dist{ -20, size.x() + 20 };
+    std::uniform_int_distribution<int> y_dist{ -20, size.y() + 20 };
+    std::uniform_int_distribution<int> byte_dist{ 0, 255 };
+
+    const auto random_point = [&]() { return gx::point{ x_dist(engine), y_dist(engine) }; };
+    const auto random_color = [&]() { return gx::rgb_color(gx::byte(byte_dist(engine)), gx::byte(byte_dist(engine)), gx::byte(byte_dist(engine))); };
+    const auto random_alpha = [&]() { return gx::byte(byte_dist(engine) | 1); };
+
+    gx::command_buffer<gx::rgb_color> result;
+
+    result.fill(gx::rect{ { -5, -5 }, { size.x() / 2, size.y() / 3 } }, random_color(), 200);
+
+    for (int i = 0; i < 60; ++i)
+    {
+        const auto a = random_point();
+        const geo::polygon_2d<float> shape{ a, a + gx::point{ 40, 5 }, random_point(), a + gx::point{ -7, 33 } };
+
+        result.fill(shape, random_color(), random_alpha(), i % 2 == 0 ? gx::fill_rule::non_zero : gx::fill_rule::even_odd);
+        result.draw(shape, random_color(), random_alpha());
+        result.draw_line_smooth(random_point(), random_point(), random_color(), random_alpha());
+        result.draw_circle(random_point(), i, random_color(), random_alpha());
+        result.draw_dot(random_point(), random_color());
+    }
+
+    result.draw("command\nbuffer", { 30, 61 }, gx::rgb_color(255, 255, 0), 180);
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("parallel tiled render equals sequential render")
+{
+    const gx::size_type size{ 301, 187 };
+    const auto scene = make_scene(size);
+
+    gx::rgb_image expected{ size };
+    scene.render(expected);
+
+    for (const auto& tile_size : { gx::size_type{ 128, 128 }, gx::size_type{ 37, 23 }, gx::size_type{ 400, 1 } })
+    {
+        gx::rgb_image actual{ size };
+        scene.render(gx::execution::par(4), actual, tile_size);
+
+        REQUIRE(core::equal(actual, expected));
+    }
+}
+
+TEST_CASE("render with an origin draws the matching part of the scene")
+{
+    const gx::size_type size{ 120, 90 };
+    const auto scene = make_scene(size);
+
+    gx::rgb_image expected{ size };
+    scene.render(expected);
+
+    gx::rgb_image actual{ size };
+    scene.render(actual.view().region({ { 0, 0 }, { 60, 90 } }));
+    scene.render(gx::execution::par, actual.view().region({ { 60, 0 }, { 120, 90 } }), { 16, 16 }, { 60, 0 });
+
+    REQUIRE(core::equal(actual, expected));
+}
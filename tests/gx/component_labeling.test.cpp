@@ -0,0 +1,105 @@
+#include <catch.hpp>
+#include <vector>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/component_labeling.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+/* flood fill from every unlabeled pixel in raster order */
+gx::image<std::int32_t> label_reference(const gx::byte_image& image, gx::connectivity connectivity)
+{
+    gx::image<std::int32_t> result{ image.size() };
+    std::int32_t count = 0;
+    std::vector<gx::location_type> stack;
+
+    for (int y = 0; y < image.height(); ++y)
+    {
+        for (int x = 0; x < image.width(); ++x)
+        {
+            if (image[{ x, y }] == 0 || result[{ x, y }] != 0)
+            {
+                continue;
+            }
+
+            ++count;
+            result[{ x, y }] = count;
+            stack.push_back({ x, y });
+
+            while (!stack.empty())
+            {
+                const auto p = stack.back();
+                stack.pop_back();
+
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        const gx::location_type n{ p.x() + dx, p.y() + dy };
+
+                        if ((connectivity == gx::connectivity::four && dx != 0 && dy != 0)
+                            || n.x() < 0 || n.y() < 0 || n.x() >= image.width() || n.y() >= image.height()
+                            || image[n] == 0 || result[n] != 0)
+                        {
+                            continue;
+                        }
+
+                        result[n] = count;
+                        stack.push_back(n);
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("label_components matches flood fill")
+{
+    const auto image = test_helpers::make_random_mask({ 157, 211 }, 45, 11);
+
+    for (auto connectivity : { gx::connectivity::four, gx::connectivity::eight })
+    {
+        const auto expected = label_reference(image, connectivity);
+
+        REQUIRE(core::equal(gx::label_components(image, connectivity).labels, expected));
+        REQUIRE(core::equal(gx::label_components(gx::execution::par(4), image, connectivity).labels, expected));
+    }
+}
+
+TEST_CASE("label_components statistics")
+{
+    gx::byte_image image{ { 40, 100 } };
+
+    /* an L shape crossing every strip border and a separate square */
+    core::fill(image.view().region({ { 2, 3 }, { 5, 97 } }), 1);
+    core::fill(image.view().region({ { 5, 90 }, { 30, 97 } }), 1);
+    core::fill(image.view().region({ { 20, 10 }, { 24, 14 } }), 1);
+
+    for (const auto& result : { gx::label_components(image), gx::label_components(gx::execution::par(3), image) })
+    {
+        REQUIRE(result.components.size() == 2);
+
+        const auto& l_shape = result.components[0];
+        REQUIRE(l_shape.area == 3 * 94 + 25 * 7);
+        REQUIRE(l_shape.bounds.lower() == gx::location_type{ 2, 3 });
+        REQUIRE(l_shape.bounds.upper() == gx::location_type{ 30, 97 });
+
+        const auto& square = result.components[1];
+        REQUIRE(square.area == 16);
+        REQUIRE(square.bounds.lower() == gx::location_type{ 20, 10 });
+        REQUIRE(square.bounds.upper() == gx::location_type{ 24, 14 });
+        REQUIRE(square.centroid.x() == Approx(21.5));
+        REQUIRE(square.centroid.y() == Approx(11.5));
+
+        REQUIRE(result.labels[{ 21, 11 }] == 2);
+        REQUIRE(result.labels[{ 29, 96 }] == 1);
+        REQUIRE(result.labels[{ 0, 0 }] == 0);
+    }
+}
@@ -0,0 +1,243 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/gradient.hpp>
+#include <cpp_essentials/gx/kernels.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+template <class Convolution>
+gx::byte_image convolve_reference(const gx::byte_image& source, const Convolution& convolution)
+{
+    gx::byte_image result{ source.size() };
+    gx::detail::convolve_regions(source, result, convolution);
+    return result;
+}
+
+int max_difference(const gx::byte_image& lhs, const gx::byte_image& rhs)
+{
+    int result = 0;
+    auto it = rhs.begin();
+
+    for (auto v : lhs)
+    {
+        result = std::max(result, std::abs(int(v) - int(*it++)));
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("separable kernel detection")
+{
+    REQUIRE(gx::kernels::blur().is_separable());
+    REQUIRE(gx::kernels::box_blur({ 7, 3 }).is_separable());
+    REQUIRE(gx::kernels::sobel(gx::orientation::horizontal).is_separable());
+    REQUIRE(!gx::kernels::sharpen().is_separable());
+    REQUIRE(!gx::kernels::edge_detect().is_separable());
+}
+
+TEST_CASE("separable convolution")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 41, 23 });
+
+    for (const auto& convolution : { gx::kernels::blur(), gx::kernels::box_blur({ 5, 3 }), gx::kernels::separable({ 1.F, 2.F, 1.F }, { 0.5F, 0.5F }) })
+    {
+        gx::byte_image dest{ source.size() };
+        gx::convolve(source, dest, convolution);
+        REQUIRE(max_difference(dest, convolve_reference(source, convolution)) <= 1);
+    }
+}
+
+TEST_CASE("small kernel convolution")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 77, 19 });
+
+    for (const auto& convolution : { gx::kernels::sharpen(), gx::kernels::emboss(), gx::kernels::edge_detect(), gx::kernels::box_blur({ 5, 5 }) })
+    {
+        const auto expected = convolve_reference(source, convolution);
+
+        for (auto level : { gx::detail::simd_level::none, gx::detail::simd_level::sse2, gx::detail::simd_level::avx2 })
+        {
+            if (level > gx::detail::get_simd_level())
+            {
+                continue;
+            }
+
+            gx::byte_image dest{ source.size() };
+            gx::detail::convolve_small_kernel(source, dest, convolution._kernel, level);
+            REQUIRE(max_difference(dest, expected) == 0);
+        }
+    }
+}
+
+TEST_CASE("small kernel convolution on rgb image")
+{
+    const auto gray = test_helpers::make_test_image<gx::byte>({ 45, 12 });
+
+    gx::rgb_image source{ gray.size() };
+    core::transform(gray, source.begin(), [](gx::byte v) { return gx::rgb_color(v, 255 - v, v / 2); });
+
+    gx::rgb_image dest{ source.size() };
+    gx::convolve(source, dest, gx::kernels::sharpen());
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto expected = convolve_reference(gx::byte_image{ gx::channel(source.view(), i) }, gx::kernels::sharpen());
+        REQUIRE(max_difference(gx::byte_image{ gx::channel(dest.view(), i) }, expected) == 0);
+    }
+}
+
+TEST_CASE("parallel convolution")
+{
+    for (const auto& size : { gx::image_size_t{ 57, 300 }, gx::image_size_t{ 40, 9 } })
+    {
+        const auto source = test_helpers::make_test_image<gx::byte>(size);
+
+        for (const auto& convolution : { gx::kernels::sharpen(), gx::kernels::blur(), gx::kernels::box_blur({ 7, 5 }), gx::kernels::emboss() })
+        {
+            gx::byte_image expected{ source.size() };
+            gx::convolve(source, expected, convolution);
+
+            /* 64 bands exceed the height of the second image */
+            for (auto thread_count : { 3, 7, 64 })
+            {
+                gx::byte_image actual{ source.size() };
+                gx::convolve(gx::execution::par(thread_count), source, actual, convolution);
+                REQUIRE(core::equal(actual, expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("parallel convolution on rgb image")
+{
+    const auto gray = test_helpers::make_test_image<gx::byte>({ 45, 70 });
+
+    gx::rgb_image source{ gray.size() };
+    core::transform(gray, source.begin(), [](gx::byte v) { return gx::rgb_color(v, 255 - v, v / 2); });
+
+    gx::rgb_image expected{ source.size() };
+    gx::convolve(source, expected, gx::kernels::blur());
+
+    gx::rgb_image actual{ source.size() };
+    gx::convolve(gx::execution::par(4), source, actual, gx::kernels::blur());
+
+    REQUIRE(core::equal(actual, expected));
+}
+
+TEST_CASE("fixed point kernel detection")
+{
+    REQUIRE(gx::kernels::sharpen().is_fixed_point());
+    REQUIRE(gx::kernels::blur().is_fixed_point());
+    REQUIRE(gx::kernels::sobel(gx::orientation::vertical).is_fixed_point());
+    REQUIRE(!gx::kernels::box_blur({ 3, 3 }).is_fixed_point());
+
+    /* 289 taps of 30000 sum far past 2^24 / 255 */
+    gx::kernel_type large{ { 17, 17 } };
+    core::fill(large, 30000.F);
+    REQUIRE(!gx::detail::make_fixed_point(large).has_value());
+
+    /* exactly at the limit of the magnitude */
+    gx::kernel_type limit{ { 1, 3 } };
+    core::copy(std::vector<float>{ 30000.F, -30000.F, 5793.F }, limit.begin());
+    REQUIRE(gx::detail::make_fixed_point(limit).has_value());
+
+    limit[{ 0, 2 }] = 5794.F;
+    REQUIRE(!gx::detail::make_fixed_point(limit).has_value());
+}
+
+TEST_CASE("fixed point convolution")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 70, 21 });
+
+    gx::kernel_type large{ { 7, 7 } };
+
+    for (auto it : core::views::iterate(large))
+    {
+        const auto loc = it.location();
+        *it = float((loc.x() * 5 + loc.y() * 3 + loc.x() * loc.y()) % 7 - 3);
+    }
+
+    gx::kernel_type wide = large;
+    wide[{ 3, 3 }] = 300.F;
+
+    for (const auto& convolution : { gx::kernels::sharpen(), gx::kernels::blur(), gx::kernels::emboss(), gx::kernels::cross(gx::orientation::horizontal), gx::kernel_convolution_t<1>{ { large } }, gx::kernel_convolution_t<1>{ { wide } } })
+    {
+        REQUIRE(convolution.is_fixed_point());
+
+        const auto expected = convolve_reference(source, convolution);
+
+        for (auto level : { gx::detail::simd_level::none, gx::detail::simd_level::sse2, gx::detail::simd_level::avx2 })
+        {
+            if (level > gx::detail::get_simd_level())
+            {
+                continue;
+            }
+
+            gx::byte_image dest{ source.size() };
+            gx::detail::convolve_fixed_point(source, dest, *convolution._fixed_point, level);
+            REQUIRE(max_difference(dest, expected) == 0);
+        }
+    }
+}
+
+TEST_CASE("fused gradient")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 53, 19 });
+
+    for (const auto& convolution : { gx::kernels::sobel(), gx::kernels::prewitt(), gx::kernels::cross() })
+    {
+        gx::byte_image dest{ source.size() };
+        gx::convolve(source, dest, convolution);
+        REQUIRE(max_difference(dest, convolve_reference(source, convolution)) == 0);
+
+        for (auto norm : { gx::gradient_norm::l2, gx::gradient_norm::l1, gx::gradient_norm::squared })
+        {
+            gx::image<std::int32_t> expected{ source.size() };
+            gx::detail::region_gradient<std::int32_t>(source, expected, nullptr, convolution._kernels[0], convolution._kernels[1], norm);
+
+            for (auto level : { gx::detail::simd_level::none, gx::detail::simd_level::sse2, gx::detail::simd_level::avx2 })
+            {
+                if (level > gx::detail::get_simd_level())
+                {
+                    continue;
+                }
+
+                gx::image<std::int32_t> actual{ source.size() };
+                gx::detail::fused_gradient<std::int32_t>(source, actual, nullptr, *convolution._fixed_point[0], *convolution._fixed_point[1], norm, level);
+                REQUIRE(core::equal(actual, expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("gradient direction")
+{
+    gx::byte_image source{ { 6, 6 } };
+
+    for (auto it : core::views::iterate(source))
+    {
+        *it = it.location().x() < 3 ? 0 : 200;
+    }
+
+    gx::byte_image magnitude{ source.size() };
+    gx::byte_image direction{ source.size() };
+    gx::gradient(source, magnitude, direction, gx::kernels::sobel(), gx::gradient_norm::l1);
+
+    REQUIRE(magnitude[{ 1, 1 }] == 255);
+    REQUIRE(direction[{ 1, 1 }] == 0);
+    REQUIRE(magnitude[{ 3, 1 }] == 0);
+
+    for (auto it : core::views::iterate(source))
+    {
+        *it = it.location().x() < it.location().y() ? 0 : 200;
+    }
+
+    gx::gradient(source, magnitude, direction, gx::kernels::sobel());
+
+    REQUIRE(direction[{ 2, 2 }] == 3);
+}
@@ -0,0 +1,69 @@
+#include <catch.hpp>
+#include <climits>
+#include <cmath>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/distance_transform.hpp>
+#include <cpp_essentials/gx/morphological_operations.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+TEST_CASE("distance_transform matches brute force")
+{
+    const auto mask = test_helpers::make_random_mask({ 67, 43 }, 98, 5);
+
+    const auto actual = gx::distance_transform(mask);
+    const auto parallel = gx::distance_transform(gx::execution::par(4), mask);
+
+    for (auto it : core::views::iterate(actual))
+    {
+        const auto p = it.location();
+
+        int best = INT_MAX;
+
+        for (auto other : core::views::iterate(mask))
+        {
+            if (*other == 0)
+            {
+                const auto d = other.location() - p;
+                best = std::min(best, d.x() * d.x() + d.y() * d.y());
+            }
+        }
+
+        REQUIRE(*it == Approx(std::sqrt(float(best))));
+    }
+
+    REQUIRE(core::equal(actual, parallel));
+}
+
+TEST_CASE("distance_transform without background")
+{
+    gx::byte_image mask{ { 5, 4 } };
+    core::fill(mask, 1);
+
+    REQUIRE(core::all_of(gx::distance_transform(mask), [](float v) { return std::isinf(v); }));
+}
+
+TEST_CASE("disk morphology matches ellipse structuring elements")
+{
+    const auto mask = test_helpers::make_random_mask({ 80, 60 }, 97, 5);
+    const int radius = 4;
+    const auto element = gx::create_structuring_element({ 2 * radius + 1, 2 * radius + 1 }, gx::structuring_element::ellipse);
+    const gx::image_region_t valid{ { radius, radius }, { 80 - radius, 60 - radius } };
+
+    gx::byte_image eroded{ mask.size() };
+    gx::erode_disk(mask, eroded, radius);
+
+    gx::byte_image expected_eroded{ valid.size() };
+    gx::convolve(mask, expected_eroded, gx::erosion(element));
+
+    REQUIRE(core::equal(eroded.view().region(valid), expected_eroded));
+
+    gx::byte_image dilated{ mask.size() };
+    gx::dilate_disk(gx::execution::par(3), eroded, dilated, radius);
+
+    gx::byte_image expected_dilated{ valid.size() };
+    gx::convolve(eroded, expected_dilated, gx::dilation(element));
+
+    REQUIRE(core::equal(dilated.view().region(valid), expected_dilated));
+}
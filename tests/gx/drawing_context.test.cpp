@@ -0,0 +1,277 @@
+#include <catch.hpp>
+#include <random>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/drawing_context.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+/* winding number of the polygon around the point */
+int get_winding(const geo::polygon_2d<float>& shape, float x, float y)
+{
+    int result = 0;
+
+    for (size_t i = 0; i < geo::vertex_count(shape); ++i)
+    {
+        const auto a = geo::get_vertex(shape, i);
+        const auto b = geo::get_vertex(shape, (i + 1) % geo::vertex_count(shape));
+
+        if ((a.y() <= y) != (b.y() <= y))
+        {
+            const auto cross_x = a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+
+            if (x < cross_x)
+            {
+                result += a.y() < b.y() ? 1 : -1;
+            }
+        }
+    }
+
+    return result;
+}
+
+gx::byte_image fill_reference(const gx::size_type& size, const geo::polygon_2d<float>& shape, gx::fill_rule rule)
+{
+    gx::byte_image result{ size };
+
+    for (auto it : core::views::iterate(result))
+    {
+        const auto winding = get_winding(shape, it.location().x() + 0.5F, it.location().y() + 0.5F);
+        const auto inside = rule == gx::fill_rule::even_odd ? (winding % 2) != 0 : winding != 0;
+
+        *it = inside ? 255 : 0;
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("polygon fill rules")
+{
+    /* concave, with several spans per row, and a self-intersecting star */
+    const geo::polygon_2d<float> comb{ { 2.3F, 3.1F }, { 40.7F, 2.2F }, { 38.2F, 30.6F }, { 30.1F, 8.4F }, { 22.5F, 29.9F }, { 14.8F, 9.3F }, { 6.1F, 31.2F } };
+    const geo::polygon_2d<float> star{ { 20.F, 1.F }, { 32.F, 38.F }, { 1.F, 15.F }, { 39.F, 15.F }, { 8.F, 38.F } };
+    const geo::polygon_2d<float> clipped{ { -10.F, -5.F }, { 60.F, 12.F }, { 20.F, 55.F } };
+
+    for (const auto& shape : { comb, star, clipped })
+    {
+        for (auto rule : { gx::fill_rule::even_odd, gx::fill_rule::non_zero })
+        {
+            gx::byte_image actual{ { 43, 40 } };
+            gx::make_drawing_context(actual).fill(shape, 255, 255, rule);
+
+            REQUIRE(core::equal(actual, fill_reference(actual.size(), shape, rule)));
+        }
+    }
+}
+
+TEST_CASE("adjacent polygons do not overlap")
+{
+    const geo::polygon_2d<float> left{ { 0.F, 0.F }, { 17.3F, 0.F }, { 9.6F, 30.F }, { 0.F, 30.F } };
+    const geo::polygon_2d<float> right{ { 17.3F, 0.F }, { 30.F, 0.F }, { 30.F, 30.F }, { 9.6F, 30.F } };
+
+    gx::byte_image image{ { 30, 30 } };
+    auto context = gx::make_drawing_context(image);
+
+    context.fill(left, 0, 1);
+    context.fill(right, 0, 1);
+
+    REQUIRE(core::all_of(image, [](gx::byte v) { return v == 0; }));
+
+    gx::byte_image counts{ { 30, 30 } };
+    gx::make_drawing_context(counts).fill(left, 100).fill(right, 200);
+
+    REQUIRE(core::all_of(counts, [](gx::byte v) { return v == 100 || v == 200; }));
+}
+
+TEST_CASE("translucent spans")
+{
+    gx::rgb_image image{ { 70, 9 } };
+
+    for (auto it : core::views::iterate(image))
+    {
+        *it = gx::rgb_color(gx::byte(it.location().x() * 3), gx::byte(it.location().y() * 20), 77);
+    }
+
+    auto expected = image;
+
+    const auto color = gx::rgb_color(200, 10, 130);
+
+    for (auto it : core::views::iterate(expected.view().region({ { 3, 2 }, { 67, 6 } })))
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            (*it)[c] = gx::detail::blend_channel(color[c], (*it)[c], 90);
+        }
+    }
+
+    gx::make_drawing_context(image).fill(gx::rect{ { 3, 2 }, { 67, 6 } }, color, 90);
+
+    REQUIRE(core::equal(image, expected));
+}
+
+TEST_CASE("lines and circles match the per-pixel reference")
+{
+    const gx::rgb_color color(40, 220, 180);
+    const gx::byte alpha = 100;
+
+    gx::rgb_image image{ { 50, 40 } };
+    core::fill(image, gx::rgb_color(10, 20, 30));
+
+    auto expected = image;
+
+    const auto plot = [&](const gx::point& p)
+    {
+        if (p.x() >= 0 && p.x() < expected.width() && p.y() >= 0 && p.y() < expected.height())
+        {
+            auto& dst = expected[p];
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                dst[c] = gx::detail::blend_channel(color[c], dst[c], alpha);
+            }
+        }
+    };
+
+    auto context = gx::make_drawing_context(image);
+
+    /* shallow, steep, reversed, degenerate and clipped */
+    const gx::point ends[][2] = {
+        { { 2, 3 }, { 45, 11 } }, { { 30, 1 }, { 24, 38 } }, { { 47, 35 }, { 3, 20 } },
+        { { 8, 8 }, { 8, 8 } }, { { -20, 5 }, { 70, 33 } }, { { 10, -9 }, { 12, 60 } } };
+
+    for (const auto& e : ends)
+    {
+        context.draw_line(e[0], e[1], color, alpha);
+        gx::bresenham_line(e[0], e[1], plot);
+    }
+
+    context.draw_circle({ 25, 20 }, 13, color, alpha);
+    gx::bresenham_circle({ 25, 20 }, 13, plot);
+
+    context.draw_circle({ 45, 5 }, 9, color, alpha);
+    gx::bresenham_circle({ 45, 5 }, 9, plot);
+
+    REQUIRE(core::equal(image, expected));
+}
+
+TEST_CASE("clipped lines and rects match the per-pixel reference")
+{
+    std::mt19937 engine{ 7 };
+    std::uniform_int_distribution<int> near_coord{ -30, 60 };
+    std::uniform_int_distribution<int> far_coord{ -5000, 5000 };
+
+    const gx::point origin{ 11, -4 };
+    const gx::size_type size{ 37, 23 };
+
+    const auto contains = [&](const gx::point& p)
+    {
+        return p.x() >= origin.x() && p.x() < origin.x() + size.x() && p.y() >= origin.y() && p.y() < origin.y() + size.y();
+    };
+
+    for (int i = 0; i < 400; ++i)
+    {
+        auto& coord = i % 4 == 3 ? far_coord : near_coord;
+        const gx::point start{ coord(engine), coord(engine) };
+        const gx::point end{ near_coord(engine), near_coord(engine) };
+
+        gx::byte_image image{ size };
+        core::fill(image, 0);
+        gx::drawing_context<gx::byte>{ image, origin }.draw_line(start, end, 255);
+
+        gx::byte_image expected{ size };
+        core::fill(expected, 0);
+        gx::bresenham_line(start, end, [&](const gx::point& p)
+        {
+            if (contains(p))
+            {
+                expected[p - origin] = 255;
+            }
+        });
+
+        REQUIRE(core::equal(image, expected));
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const gx::point a{ near_coord(engine), near_coord(engine) };
+        const gx::point b{ a.x() + near_coord(engine) + 30, a.y() + near_coord(engine) + 30 };
+        const gx::rect rect{ a, b };
+
+        gx::byte_image image{ size };
+        core::fill(image, 0);
+        gx::drawing_context<gx::byte>{ image, origin }.fill(rect, 255);
+
+        gx::byte_image expected{ size };
+
+        for (auto it : core::views::iterate(expected))
+        {
+            const auto p = it.location() + origin;
+
+            *it = p.x() >= geo::left(rect) && p.x() <= geo::right(rect) && p.y() >= geo::top(rect) && p.y() <= geo::bottom(rect) ? 255 : 0;
+        }
+
+        REQUIRE(core::equal(image, expected));
+    }
+}
+
+TEST_CASE("text matches the font bitmaps")
+{
+    const std::vector<gx::text_label> labels = {
+        { "Cell #1", { 3, 2 } },
+        { "clipped\nlabel", { -13, 30 } },
+        { "edge", { 50, 35 } },
+        { "gone", { 200, 5 } } };
+
+    gx::byte_image expected{ { 70, 45 } };
+    core::fill(expected, 10);
+
+    for (const auto& label : labels)
+    {
+        auto loc = label.location;
+
+        for (auto ch : label.text)
+        {
+            if (ch == '\n')
+            {
+                loc = gx::point{ label.location.x(), loc.y() + 8 };
+                continue;
+            }
+
+            for (int y = 0; y < 8; ++y)
+            {
+                for (int x = 0; x < 8; ++x)
+                {
+                    const auto p = loc + gx::point{ x, y };
+
+                    if ((gx::detail::font8x8_basic[size_t(ch)][y] & 1 << x) && p.x() >= 0 && p.x() < 70 && p.y() >= 0 && p.y() < 45)
+                    {
+                        expected[p] = gx::detail::blend_channel(250, expected[p], 150);
+                    }
+                }
+            }
+
+            loc = loc + gx::point{ 8, 0 };
+        }
+    }
+
+    gx::byte_image batched{ { 70, 45 } };
+    core::fill(batched, 10);
+    gx::make_drawing_context(batched).draw_text(labels, 250, 150);
+
+    REQUIRE(core::equal(batched, expected));
+
+    gx::byte_image single{ { 70, 45 } };
+    core::fill(single, 10);
+    auto context = gx::make_drawing_context(single);
+
+    for (const auto& label : labels)
+    {
+        context.draw(label.text, label.location, 250, 150);
+    }
+
+    REQUIRE(core::equal(single, expected));
+}
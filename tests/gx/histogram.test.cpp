@@ -0,0 +1,142 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/histogram_operations.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+gx::detail::histogram_t count_values(gx::byte_image::const_view_type image)
+{
+    gx::detail::histogram_t result;
+    result.fill(0);
+
+    for (auto v : image)
+    {
+        ++result[v];
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("histogram of byte image")
+{
+    const auto source = test_helpers::make_test_image<gx::rgb_color>({ 67, 31 });
+    const gx::byte_image gray{ gx::channel(source.view(), 0) };
+
+    REQUIRE(gx::detail::make_histogram(gray.view()) == count_values(gray.view()));
+    REQUIRE(gx::detail::make_histogram(gx::channel(source.view(), 1)) == count_values(gx::channel(source.view(), 1)));
+    REQUIRE(gx::detail::make_histogram(gx::execution::par(3), gray.view()) == count_values(gray.view()));
+    REQUIRE(gx::detail::make_histogram(gx::execution::par(64), gray.view()) == count_values(gray.view()));
+}
+
+TEST_CASE("histogram of rgb image")
+{
+    const auto source = test_helpers::make_test_image<gx::rgb_color>({ 45, 140 });
+
+    const auto histograms = gx::detail::make_histogram(source.view());
+    const auto parallel = gx::detail::make_histogram(gx::execution::par(4), source.view());
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(histograms[i] == count_values(gx::channel(source.view(), i)));
+        REQUIRE(parallel[i] == histograms[i]);
+    }
+}
+
+TEST_CASE("equalize rgb image per channel")
+{
+    const auto source = test_helpers::make_test_image<gx::rgb_color>({ 33, 21 });
+
+    gx::rgb_image actual{ source.size() };
+    gx::equalize(source, actual);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        gx::byte_image expected{ source.size() };
+        gx::equalize(gx::channel(source.view(), i), expected);
+
+        REQUIRE(core::equal(gx::channel(actual.view(), i), expected));
+    }
+}
+
+TEST_CASE("parallel equalize")
+{
+    for (const auto& size : { gx::image_size_t{ 70, 260 }, gx::image_size_t{ 33, 5 } })
+    {
+        const auto source = test_helpers::make_test_image<gx::rgb_color>(size);
+        const gx::byte_image gray{ gx::channel(source.view(), 1) };
+
+        gx::byte_image expected_gray{ size };
+        gx::equalize(gray, expected_gray);
+
+        gx::rgb_image expected_rgb{ size };
+        gx::equalize(source, expected_rgb);
+
+        /* 64 bands exceed the height of the second image */
+        for (auto thread_count : { 3, 64 })
+        {
+            gx::byte_image actual_gray{ size };
+            gx::equalize(gx::execution::par(thread_count), gray, actual_gray);
+            REQUIRE(core::equal(actual_gray, expected_gray));
+
+            gx::rgb_image actual_rgb{ size };
+            gx::equalize(gx::execution::par(thread_count), source, actual_rgb);
+            REQUIRE(core::equal(actual_rgb, expected_rgb));
+        }
+    }
+}
+
+TEST_CASE("adaptive_equalize with one tile and no clipping is global equalization")
+{
+    const auto rgb = test_helpers::make_test_image<gx::rgb_color>({ 61, 47 });
+    const auto image = gx::red_channel(rgb.view());
+
+    const auto cum_hist = gx::detail::accumulate_histogram(count_values(image));
+    const auto total = cum_hist.back();
+
+    gx::byte_image expected{ image.size() };
+
+    for (auto it : core::views::iterate(expected))
+    {
+        *it = gx::byte((255 * cum_hist[image[it.location()]] + total / 2) / total);
+    }
+
+    gx::byte_image actual{ image.size() };
+    gx::adaptive_equalize(image, actual, { 1, 1 }, 256.F);
+
+    REQUIRE(core::equal(actual, expected));
+}
+
+TEST_CASE("adaptive_equalize tiles")
+{
+    gx::byte_image image{ { 96, 80 } };
+
+    for (auto it : core::views::iterate(image))
+    {
+        const auto loc = it.location();
+        *it = gx::byte(loc.x() < 48 ? (loc.x() * loc.y()) % 40 : 150 + (loc.x() * 3 + loc.y()) % 90);
+    }
+
+    gx::byte_image expected{ image.size() };
+    gx::adaptive_equalize(image, expected, { 4, 2 }, 3.F);
+
+    /* left of and above the first tile center only the first tile's table applies */
+    auto histogram = count_values(image.view().region({ { 0, 0 }, { 24, 40 } }));
+    gx::detail::clip_histogram(histogram, size_t(3.F * 24 * 40 / 256));
+    const auto cum_hist = gx::detail::accumulate_histogram(histogram);
+
+    REQUIRE(expected[{ 5, 7 }] == gx::byte((255 * cum_hist[image[{ 5, 7 }]] + cum_hist.back() / 2) / cum_hist.back()));
+
+    gx::byte_image parallel{ image.size() };
+    gx::adaptive_equalize(gx::execution::par(3), image, parallel, { 4, 2 }, 3.F);
+
+    REQUIRE(core::equal(parallel, expected));
+
+    gx::adaptive_equalize(image, { 4, 2 }, 3.F);
+
+    REQUIRE(core::equal(image, expected));
+}
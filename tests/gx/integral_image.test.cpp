@@ -0,0 +1,111 @@
+#include <catch.hpp>
+#include <cmath>
+#include <cpp_essentials/gx/integral_image.hpp>
+#include <cpp_essentials/gx/kernels.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+double region_sum(const gx::byte_image& image, const gx::image_region_t& region)
+{
+    double result = 0;
+
+    for (auto v : image.region(region))
+    {
+        result += v;
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("integral image sum and mean")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 23, 17 });
+    const gx::integral_image integral{ source.view() };
+
+    REQUIRE(integral.size() == source.size());
+
+    for (const auto& region : { gx::image_region_t{ { 0, 0 }, { 23, 17 } }, gx::image_region_t{ { 3, 5 }, { 11, 6 } }, gx::image_region_t{ { 22, 16 }, { 23, 17 } } })
+    {
+        REQUIRE(integral.sum(region) == region_sum(source, region));
+    }
+
+    REQUIRE(integral.mean({ { 4, 4 }, { 4, 9 } }) == 0.0);
+}
+
+TEST_CASE("integral image variance")
+{
+    gx::byte_image source{ { 4, 2 } };
+    core::copy(std::vector<gx::byte>{ 2, 4, 4, 4, 5, 5, 7, 9 }, source.begin());
+
+    const gx::squared_integral_image integral{ source.view() };
+
+    REQUIRE(integral.mean({ { 0, 0 }, { 4, 2 } }) == Approx(5.0));
+    REQUIRE(integral.variance({ { 0, 0 }, { 4, 2 } }) == Approx(4.0));
+    REQUIRE(integral.standard_deviation({ { 0, 0 }, { 4, 2 } }) == Approx(2.0));
+    REQUIRE(integral.variance({ { 1, 0 }, { 4, 1 } }) == Approx(0.0));
+}
+
+TEST_CASE("box blur uses integral image")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 41, 29 });
+    const auto convolution = gx::kernels::box_blur({ 9, 7 });
+
+    gx::byte_image actual{ source.size() };
+    gx::byte_image expected{ source.size() };
+
+    gx::convolve(source, actual, convolution);
+    gx::detail::convolve_regions(source, expected, convolution);
+
+    REQUIRE(core::equal(actual, expected, [](int lhs, int rhs) { return std::abs(lhs - rhs) <= 1; }));
+}
+
+TEST_CASE("adaptive threshold")
+{
+    gx::byte_image source{ { 8, 8 } };
+    source = gx::byte(100);
+    source[{ 3, 3 }] = 120;
+    source[{ 6, 1 }] = 80;
+
+    gx::byte_image dest{ source.size() };
+    gx::adaptive_threshold(source, dest, { 5, 5 }, 0);
+
+    REQUIRE(dest[{ 3, 3 }] == 255);
+    REQUIRE(dest[{ 6, 1 }] == 0);
+}
+
+TEST_CASE("local normalize")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 31, 19 });
+    const gx::size_type window_size{ 7, 5 };
+
+    gx::byte_image actual{ source.size() };
+    gx::local_normalize(source, actual, window_size, 120.F, 50.F);
+
+    for (int y = 0; y < source.height(); ++y)
+    {
+        for (int x = 0; x < source.width(); ++x)
+        {
+            const auto window = gx::detail::get_window({ x, y }, window_size, source.size());
+            const auto area = double(window.size().x() * window.size().y());
+            const auto mean = region_sum(source, window) / area;
+
+            double squares = 0;
+
+            for (auto v : source.region(window))
+            {
+                squares += (v - mean) * (v - mean);
+            }
+
+            const auto deviation = std::max(std::sqrt(squares / area), 1.0);
+            const auto expected = gx::to_byte(120.0 + 50.0 * (source[{ x, y }] - mean) / deviation + 0.5);
+
+            REQUIRE(std::abs(actual[{ x, y }] - expected) <= 1);
+        }
+    }
+}
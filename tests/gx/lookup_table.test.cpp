@@ -0,0 +1,68 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/lookup_table.hpp>
+#include <cpp_essentials/gx/filters.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+const auto test_lut = gx::make_lut([](int v) { return (v * 37 + 11) % 256; });
+
+} /* namespace */
+
+TEST_CASE("lut row at every simd level")
+{
+    std::vector<gx::byte> source(301);
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = gx::byte(i * 89);
+    }
+
+    for (auto level : { gx::detail::simd_level::none, gx::detail::simd_level::sse2, gx::detail::simd_level::avx2 })
+    {
+        if (level > gx::detail::get_simd_level())
+        {
+            continue;
+        }
+
+        std::vector<gx::byte> dest(source.size());
+        gx::detail::lut_row(test_lut.table().data(), source.data(), dest.data(), int(source.size()), level);
+
+        REQUIRE(core::equal(dest, source, [](gx::byte actual, gx::byte value) { return actual == test_lut(value); }));
+    }
+}
+
+TEST_CASE("apply lut to byte and color images")
+{
+    const auto rgba = test_helpers::make_test_image<gx::rgba_color>({ 37, 9 });
+
+    gx::rgba_image rgba_dest{ rgba.size() };
+    gx::apply(test_lut, rgba, rgba_dest);
+    REQUIRE(core::equal(rgba_dest, rgba, [](const gx::rgba_color& actual, const gx::rgba_color& value) { return actual == test_lut(value); }));
+
+    gx::rgb_image rgb{ rgba.size() };
+    core::transform(rgba, rgb.begin(), [](const gx::rgba_color& c) { return gx::rgb_color(c[0], c[1], c[2]); });
+
+    gx::rgb_image rgb_dest{ rgb.size() };
+    gx::apply(test_lut, rgb, rgb_dest);
+    REQUIRE(core::equal(rgb_dest, rgb, [](const gx::rgb_color& actual, const gx::rgb_color& value) { return actual == test_lut(value); }));
+
+    gx::byte_image byte_dest{ rgb.size() };
+    gx::apply(test_lut, gx::channel(rgb.view(), 1), byte_dest);
+    REQUIRE(core::equal(byte_dest, gx::channel(rgb.view(), 1), [](gx::byte actual, gx::byte value) { return actual == test_lut(value); }));
+}
+
+TEST_CASE("apply colormap")
+{
+    gx::byte_image source{ { 31, 4 } };
+    core::transform(core::views::iterate(source), source.begin(), [](auto it) { return gx::byte(it.location().x() * 8 + it.location().y()); });
+
+    const gx::heatmap map;
+
+    gx::rgb_image dest{ source.size() };
+    gx::apply(map.values, source, dest);
+    REQUIRE(core::equal(dest, source, [&](const gx::rgb_color& actual, gx::byte value) { return actual == map(value); }));
+}
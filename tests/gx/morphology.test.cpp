@@ -0,0 +1,86 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/morphological_operations.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+template <class Convolution>
+bool matches_reference(const gx::byte_image& source, const Convolution& convolution)
+{
+    gx::byte_image actual{ source.size() };
+    gx::byte_image expected{ source.size() };
+
+    gx::convolve(source, actual, convolution);
+    gx::detail::convolve_regions(source, expected, convolution);
+
+    return std::equal(actual.begin(), actual.end(), expected.begin());
+}
+
+} /* namespace */
+
+TEST_CASE("dilation and erosion with box elements")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 37, 29 });
+
+    for (const auto& mask : { gx::box_3x3, gx::box_5x5, gx::create_structuring_element({ 9, 2 }, gx::structuring_element::box) })
+    {
+        REQUIRE(matches_reference(source, gx::dilation(mask)));
+        REQUIRE(matches_reference(source, gx::erosion(mask)));
+    }
+}
+
+TEST_CASE("dilation and erosion with ellipse elements")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 41, 33 });
+
+    for (const auto& mask : { gx::ellipse_3x3, gx::ellipse_5x5, gx::create_structuring_element({ 15, 11 }, gx::structuring_element::ellipse) })
+    {
+        REQUIRE(matches_reference(source, gx::dilation(mask)));
+        REQUIRE(matches_reference(source, gx::erosion(mask)));
+    }
+}
+
+TEST_CASE("dilation keeps exact values")
+{
+    gx::byte_image source{ { 5, 5 } };
+    source[{ 2, 2 }] = 255;
+
+    gx::byte_image dest{ source.size() };
+    gx::convolve(source, dest, gx::dilation(gx::box_3x3));
+
+    REQUIRE(dest[{ 0, 0 }] == 255);
+    REQUIRE(dest[{ 2, 2 }] == 255);
+
+    gx::convolve(source, dest, gx::erosion(gx::box_3x3));
+
+    REQUIRE(dest[{ 1, 1 }] == 0);
+}
+
+TEST_CASE("percentile with box and ellipse elements")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 43, 31 });
+
+    for (const auto& mask : { gx::box_3x3, gx::ellipse_5x5, gx::create_structuring_element({ 11, 7 }, gx::structuring_element::box) })
+    {
+        for (int rank : { 0, 25, 50, 100 })
+        {
+            REQUIRE(matches_reference(source, gx::percentile(mask, rank)));
+        }
+    }
+}
+
+TEST_CASE("median ignores pixels outside of mask")
+{
+    gx::byte_image source{ { 3, 3 } };
+    source = gx::byte(100);
+    source[{ 0, 0 }] = 0;
+    source[{ 2, 2 }] = 0;
+
+    gx::byte_image dest{ source.size() };
+    gx::convolve(source, dest, gx::median(gx::ellipse_3x3));
+
+    REQUIRE(dest[{ 0, 0 }] == 100);
+}
@@ -0,0 +1,81 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/planar_image.hpp>
+#include <cpp_essentials/gx/kernels.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+gx::rgb_image to_rgb(const gx::rgba_image& image)
+{
+    gx::rgb_image result{ image.size() };
+    core::transform(image, result.begin(), [](const gx::rgba_color& c) { return gx::rgb_color(c[0], c[1], c[2]); });
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("planar image channels share one allocation")
+{
+    gx::planar_rgb_image image{ { 5, 4 } };
+
+    REQUIRE(image.channel(0).size() == gx::size_type{ 5, 4 });
+    REQUIRE(image.channel(1).data() == image.channel(0).data() + 20);
+    REQUIRE(gx::detail::is_contiguous_row(image.channel(2)));
+
+    image.channels()[2][{ 1, 1 }] = 42;
+
+    REQUIRE(image.channel(2)[{ 1, 1 }] == 42);
+}
+
+TEST_CASE("deinterleave and interleave rgb")
+{
+    const auto source = to_rgb(test_helpers::make_test_image<gx::rgba_color>({ 53, 7 }));
+
+    const auto planar = gx::deinterleave(source);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(core::equal(planar.channel(i), gx::channel(source.view(), i)));
+    }
+
+    gx::rgb_image result{ source.size() };
+    gx::interleave(planar, result);
+
+    REQUIRE(core::equal(result, source));
+}
+
+TEST_CASE("deinterleave and interleave rgba")
+{
+    const auto source = test_helpers::make_test_image<gx::rgba_color>({ 37, 5 });
+
+    const auto planar = gx::deinterleave(source);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(core::equal(planar.channel(i), gx::channel(source.view(), i)));
+    }
+
+    gx::rgba_image result{ source.size() };
+    gx::interleave(planar, result);
+
+    REQUIRE(core::equal(result, source));
+}
+
+TEST_CASE("convolve planar image")
+{
+    const auto source = to_rgb(test_helpers::make_test_image<gx::rgba_color>({ 41, 13 }));
+
+    gx::rgb_image expected{ source.size() };
+    gx::convolve(source, expected, gx::kernels::blur());
+
+    gx::planar_rgb_image dest{ source.size() };
+    gx::convolve(gx::deinterleave(source), dest, gx::kernels::blur());
+
+    gx::rgb_image actual{ source.size() };
+    gx::interleave(dest, actual);
+
+    REQUIRE(core::equal(actual, expected));
+}
@@ -0,0 +1,104 @@
+#include <catch.hpp>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/pyramid.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+int clamp_to(int value, int size)
+{
+    return std::clamp(value, 0, size - 1);
+}
+
+/* reference reduction of one channel */
+gx::byte_image reduce_reference(gx::byte_image::const_view_type source, gx::pyramid_filter filter)
+{
+    gx::byte_image result{ { (source.width() + 1) / 2, (source.height() + 1) / 2 } };
+
+    static const int weights[5] = { 1, 4, 6, 4, 1 };
+
+    for (int y = 0; y < result.height(); ++y)
+    {
+        for (int x = 0; x < result.width(); ++x)
+        {
+            int sum = 0;
+
+            if (filter == gx::pyramid_filter::box)
+            {
+                for (int dy = 0; dy < 2; ++dy)
+                {
+                    for (int dx = 0; dx < 2; ++dx)
+                    {
+                        sum += source[{ clamp_to(2 * x + dx, source.width()), clamp_to(2 * y + dy, source.height()) }];
+                    }
+                }
+
+                result[{ x, y }] = gx::byte((sum + 2) / 4);
+            }
+            else
+            {
+                for (int dy = -2; dy <= 2; ++dy)
+                {
+                    for (int dx = -2; dx <= 2; ++dx)
+                    {
+                        sum += weights[dy + 2] * weights[dx + 2] * source[{ clamp_to(2 * x + dx, source.width()), clamp_to(2 * y + dy, source.height()) }];
+                    }
+                }
+
+                result[{ x, y }] = gx::byte((sum + 128) / 256);
+            }
+        }
+    }
+
+    return result;
+}
+
+template <class Pyramid>
+void check_levels(const Pyramid& pyramid, size_t channels, gx::pyramid_filter filter)
+{
+    for (int i = 1; i < pyramid.levels(); ++i)
+    {
+        for (size_t c = 0; c < channels; ++c)
+        {
+            const auto expected = reduce_reference(gx::byte_image{ gx::channel(pyramid.level(i - 1), c) }, filter);
+
+            REQUIRE(core::equal(gx::channel(pyramid.level(i), c), expected));
+        }
+    }
+}
+
+} /* namespace */
+
+TEST_CASE("pyramid levels share one allocation")
+{
+    const gx::pyramid<gx::byte> pyramid{ { 100, 37 }, 10 };
+
+    REQUIRE(pyramid.levels() == 8);
+    REQUIRE(pyramid.size(1) == gx::size_type{ 50, 19 });
+    REQUIRE(pyramid.size(2) == gx::size_type{ 25, 10 });
+    REQUIRE(pyramid.size(7) == gx::size_type{ 1, 1 });
+    REQUIRE(pyramid.level(2).data() == pyramid.level(1).data({ 0, 19 }));
+}
+
+TEST_CASE("build pyramid")
+{
+    const auto source = test_helpers::make_test_image<gx::rgba_color>({ 83, 61 });
+
+    for (auto filter : { gx::pyramid_filter::box, gx::pyramid_filter::gaussian })
+    {
+        const auto rgba = gx::build_pyramid(source, 5, filter);
+
+        REQUIRE(rgba.levels() == 5);
+        REQUIRE(core::equal(rgba.level(0), source));
+        check_levels(rgba, 4, filter);
+
+        gx::rgb_image rgb{ source.size() };
+        core::transform(source, rgb.begin(), [](const gx::rgba_color& c) { return c.to_rgb(); });
+
+        check_levels(gx::build_pyramid(rgb, 5, filter), 3, filter);
+        check_levels(gx::build_pyramid(gx::channel(source.view(), 1), 5, filter), 1, filter);
+    }
+}
@@ -0,0 +1,141 @@
+#include <catch.hpp>
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/resampling.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+/* direct two-dimensional evaluation of the separable weights */
+float resample_reference(const gx::image<float>& source, const gx::size_type& size, gx::resampling_filter filter, const gx::location_type& loc)
+{
+    const auto horizontal = gx::detail::make_resampling_weights(source.width(), size.x(), filter);
+    const auto vertical = gx::detail::make_resampling_weights(source.height(), size.y(), filter);
+
+    float result = 0.F;
+
+    for (int j = 0; j < vertical.count[loc.y()]; ++j)
+    {
+        for (int i = 0; i < horizontal.count[loc.x()]; ++i)
+        {
+            result += vertical.at(loc.y())[j] * horizontal.at(loc.x())[i]
+                * source[{ horizontal.first[loc.x()] + i, vertical.first[loc.y()] + j }];
+        }
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("resampling weights")
+{
+    for (auto filter : { gx::resampling_filter::bilinear, gx::resampling_filter::bicubic, gx::resampling_filter::lanczos })
+    {
+        for (auto sizes : { std::make_pair(10, 10), std::make_pair(37, 11), std::make_pair(11, 37), std::make_pair(1, 5) })
+        {
+            const auto weights = gx::detail::make_resampling_weights(sizes.first, sizes.second, filter);
+
+            for (int i = 0; i < sizes.second; ++i)
+            {
+                REQUIRE(weights.first[i] >= 0);
+                REQUIRE(weights.first[i] + weights.count[i] <= sizes.first);
+
+                float total = 0.F;
+
+                for (int k = 0; k < weights.count[i]; ++k)
+                {
+                    total += weights.at(i)[k];
+                }
+
+                REQUIRE(total == Approx(1.F));
+            }
+        }
+    }
+}
+
+TEST_CASE("resize to the same size is identity")
+{
+    const auto source = test_helpers::make_test_image<gx::rgba_color>({ 41, 23 });
+
+    for (auto filter : { gx::resampling_filter::bilinear, gx::resampling_filter::bicubic, gx::resampling_filter::lanczos })
+    {
+        gx::rgba_image dest{ source.size() };
+        gx::resize(source, dest, filter);
+
+        REQUIRE(core::equal(dest, source));
+    }
+}
+
+TEST_CASE("resize float image")
+{
+    gx::image<float> source{ { 53, 29 } };
+
+    for (auto it : core::views::iterate(source))
+    {
+        *it = float(it.location().x() * it.location().y() % 17) - 4.F;
+    }
+
+    for (auto filter : { gx::resampling_filter::bilinear, gx::resampling_filter::bicubic, gx::resampling_filter::lanczos })
+    {
+        for (auto size : { gx::size_type{ 20, 13 }, gx::size_type{ 97, 61 } })
+        {
+            gx::image<float> dest{ size };
+            gx::resize(source, dest, filter);
+
+            for (auto it : core::views::iterate(dest))
+            {
+                REQUIRE(*it == Approx(resample_reference(source, size, filter, it.location())).margin(1e-3));
+            }
+        }
+    }
+}
+
+TEST_CASE("resize simd matches scalar")
+{
+    const auto source = test_helpers::make_test_image<gx::rgba_color>({ 67, 45 });
+
+    for (auto filter : { gx::resampling_filter::bilinear, gx::resampling_filter::bicubic, gx::resampling_filter::lanczos })
+    {
+        for (auto size : { gx::size_type{ 31, 17 }, gx::size_type{ 130, 91 } })
+        {
+            const auto horizontal = gx::detail::make_resampling_weights(source.width(), size.x(), filter);
+            const auto vertical = gx::detail::make_resampling_weights(source.height(), size.y(), filter);
+
+            gx::rgba_image expected{ size };
+            gx::detail::resample_rows(horizontal, vertical, source.view(), expected.view(), 0, size.y(), gx::detail::simd_level::none);
+
+            gx::rgba_image actual{ size };
+            gx::resize(source, actual, filter);
+
+            REQUIRE(core::equal(actual, expected));
+
+            gx::rgba_image parallel{ size };
+            gx::resize(gx::execution::par(3), source, parallel, filter);
+
+            REQUIRE(core::equal(parallel, expected));
+        }
+    }
+}
+
+TEST_CASE("resampler handles byte and rgb images")
+{
+    gx::byte_image gray{ { 64, 48 } };
+    core::fill(gray, gx::byte(100));
+
+    gx::rgb_image color{ { 64, 48 } };
+    core::fill(color, gx::rgb_color(10, 200, 255));
+
+    const gx::resampler downscale{ gray.size(), { 21, 15 }, gx::resampling_filter::lanczos };
+
+    gx::byte_image small_gray{ downscale.dest_size() };
+    downscale(gray, small_gray);
+
+    gx::rgb_image small_color{ downscale.dest_size() };
+    downscale(color, small_color);
+
+    REQUIRE(core::all_of(small_gray, [](gx::byte v) { return v == 100; }));
+    REQUIRE(core::all_of(small_color, [](const gx::rgb_color& v) { return v == gx::rgb_color(10, 200, 255); }));
+}
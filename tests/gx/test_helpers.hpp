@@ -0,0 +1,65 @@
+#pragma once
+
+#include <random>
+#include <type_traits>
+
+#include <cpp_essentials/core/views/iterate.hpp>
+#include <cpp_essentials/gx/image.hpp>
+
+namespace test_helpers
+{
+
+/* Deterministic pixel data with different gradients and products per channel, so that neighbouring pixels and channels differ;
+   images made with different seeds differ everywhere. */
+template <class T>
+cpp_essentials::gx::image<T> make_test_image(const cpp_essentials::gx::image_size_t& size, int seed = 0)
+{
+    using namespace cpp_essentials;
+
+    gx::image<T> result{ size };
+
+    for (auto it : core::views::iterate(result))
+    {
+        const auto loc = it.location();
+
+        const auto value = [&](int channel)
+        {
+            return gx::byte((loc.x() * (37 + 24 * channel) + loc.y() * (91 - 30 * channel) + loc.x() * loc.y() * (13 - 4 * channel) + seed * (channel + 1)) % 256);
+        };
+
+        if constexpr (std::is_same_v<T, gx::byte>)
+        {
+            *it = value(0);
+        }
+        else if constexpr (std::is_same_v<T, gx::rgb_color>)
+        {
+            *it = gx::rgb_color(value(0), value(1), value(2));
+        }
+        else
+        {
+            *it = gx::rgba_color(value(0), value(1), value(2), value(3));
+        }
+    }
+
+    return result;
+}
+
+/* Each pixel is 255 with the given probability in percent and 0 otherwise. */
+inline cpp_essentials::gx::byte_image make_random_mask(const cpp_essentials::gx::image_size_t& size, int percent, int seed)
+{
+    using namespace cpp_essentials;
+
+    std::mt19937 engine{ std::mt19937::result_type(seed) };
+    std::uniform_int_distribution<int> dist{ 0, 99 };
+
+    gx::byte_image result{ size };
+
+    for (auto it : core::views::iterate(result))
+    {
+        *it = dist(engine) < percent ? 255 : 0;
+    }
+
+    return result;
+}
+
+} /* namespace test_helpers */
@@ -0,0 +1,109 @@
+#include <catch.hpp>
+#include <cpp_essentials/gx/tiled_operations.hpp>
+#include <cpp_essentials/gx/kernels.hpp>
+#include <cpp_essentials/gx/histogram_operations.hpp>
+#include <cpp_essentials/gx/drawing_context.hpp>
+#include <../tests/gx/test_helpers.hpp>
+
+using namespace cpp_essentials;
+
+namespace
+{
+
+gx::byte_image read_all(const gx::tiled_image<gx::byte>& image)
+{
+    gx::byte_image result{ image.size() };
+    image.read(image.bounds(), result);
+    return result;
+}
+
+} /* namespace */
+
+TEST_CASE("tiled image pages tiles to disk")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 75, 52 });
+
+    gx::tiled_image<gx::byte> tiled{ source.size(), { 16, 16 }, "tiled_image.test.tiles", 2 };
+
+    REQUIRE(tiled.grid() == gx::size_type{ 5, 4 });
+    REQUIRE(tiled.tile_region({ 4, 3 }).size() == gx::size_type{ 11, 4 });
+    REQUIRE(core::equal(read_all(tiled), gx::byte_image{ source.size() }));
+
+    tiled.write(tiled.bounds(), source);
+
+    REQUIRE(core::equal(read_all(tiled), source));
+
+    gx::byte_image part{ { 30, 20 } };
+    tiled.read({ { 10, 25 }, { 40, 45 } }, part);
+
+    REQUIRE(core::equal(part, gx::byte_image{ source.view().region({ { 10, 25 }, { 40, 45 } }) }));
+}
+
+TEST_CASE("tiled convolution")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 70, 45 });
+
+    gx::tiled_image<gx::byte> tiled_source{ source.size(), { 16, 16 }, "tiled_convolution.source.tiles", 3 };
+
+    tiled_source.write(tiled_source.bounds(), source);
+
+    for (const auto& convolution : { gx::kernels::sharpen(), gx::kernels::box_blur({ 5, 7 }) })
+    {
+        gx::byte_image expected{ source.size() };
+        gx::convolve(source, expected, convolution);
+
+        gx::tiled_image<gx::byte> tiled_dest{ source.size(), { 16, 16 }, "tiled_convolution.dest.tiles", 3 };
+        gx::convolve(tiled_source, tiled_dest, convolution);
+
+        REQUIRE(core::equal(read_all(tiled_dest), expected));
+    }
+
+    gx::byte_image expected{ source.size() };
+    gx::convolve(source, expected, gx::median(gx::ellipse_5x5));
+
+    gx::tiled_image<gx::byte> tiled_dest{ source.size(), { 16, 16 }, "tiled_convolution.dest.tiles", 3 };
+    gx::convolve(tiled_source, tiled_dest, gx::median(gx::ellipse_5x5));
+
+    REQUIRE(core::equal(read_all(tiled_dest), expected));
+
+    REQUIRE_THROWS(gx::convolve(tiled_source, tiled_source, gx::kernels::sharpen()));
+}
+
+TEST_CASE("tiled lookup table and histogram operations")
+{
+    const auto source = test_helpers::make_test_image<gx::byte>({ 61, 38 });
+
+    gx::tiled_image<gx::byte> tiled_source{ source.size(), { 32, 8 }, "tiled_lut.source.tiles", 2 };
+    gx::tiled_image<gx::byte> tiled_dest{ source.size(), { 32, 8 }, "tiled_lut.dest.tiles", 2 };
+
+    tiled_source.write(tiled_source.bounds(), source);
+
+    gx::byte_image expected{ source.size() };
+
+    gx::apply(gx::negative(), source, expected);
+    gx::apply(gx::negative(), tiled_source, tiled_dest);
+
+    REQUIRE(core::equal(read_all(tiled_dest), expected));
+
+    REQUIRE(gx::detail::make_histogram(tiled_source) == gx::detail::make_histogram(source));
+
+    gx::equalize(source, expected);
+    gx::equalize(tiled_source, tiled_dest);
+
+    REQUIRE(core::equal(read_all(tiled_dest), expected));
+}
+
+TEST_CASE("drawing on tiles")
+{
+    gx::byte_image expected{ { 50, 40 } };
+    gx::make_drawing_context(expected).fill(gx::rect{ { 5, 12 }, { 44, 30 } }, 200);
+
+    gx::tiled_image<gx::byte> tiled{ expected.size(), { 16, 16 }, "tiled_drawing.tiles", 1 };
+
+    gx::for_each_tile(tiled, { { 5, 12 }, { 45, 31 } }, [](gx::byte_image::view_type view, const gx::image_region_t& region)
+    {
+        gx::drawing_context<gx::byte>{ view, region.lower() }.fill(gx::rect{ { 5, 12 }, { 44, 30 } }, 200);
+    });
+
+    REQUIRE(core::equal(read_all(tiled), expected));
+}